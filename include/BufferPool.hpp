@@ -0,0 +1,24 @@
+#ifndef MS_BUFFER_POOL_HPP
+#define MS_BUFFER_POOL_HPP
+
+#include "common.hpp"
+#include <vector>
+
+/**
+ * Pool of heap buffers for data that outlives the call that produced it
+ * (datagrams queued in libuv, packets queued in egress queues, etc.). Sizes
+ * are rounded up to powers of two from 256 bytes to 64 KiB. Bigger buffers
+ * are not pooled. Each loop has its own pool.
+ */
+class BufferPool
+{
+public:
+	static void ClassDestroy();
+	static uint8_t* Allocate(size_t size);
+	static void Free(uint8_t* buffer);
+
+private:
+	static thread_local std::vector<uint8_t*> pools[];
+};
+
+#endif
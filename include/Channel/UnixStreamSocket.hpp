@@ -18,6 +18,22 @@ namespace Channel
 			virtual void OnChannelRemotelyClosed(Channel::UnixStreamSocket* channel) = 0;
 		};
 
+		/**
+		 * Receives the messages generated in a thread other than the one running
+		 * the Channel, which must deliver them to it.
+		 */
+		class Forwarder
+		{
+		public:
+			virtual void ForwardChannelMessage(const char* nsPayload, size_t nsPayloadLen) = 0;
+		};
+
+	public:
+		static void SetThreadForwarder(Forwarder* forwarder);
+
+	private:
+		static thread_local Forwarder* threadForwarder;
+
 	public:
 		explicit UnixStreamSocket(int fd);
 
@@ -0,0 +1,68 @@
+#ifndef MS_CHANNEL_THREAD_HPP
+#define MS_CHANNEL_THREAD_HPP
+
+#include "common.hpp"
+#include "SpscQueue.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include <uv.h>
+#include <atomic>
+#include <string>
+
+/**
+ * Thread whose messages for the Channel (responses, notifications and logs)
+ * are queued and delivered to the Channel by the loop that owns it. Base of
+ * WorkerThread and of the SrtpCryptoPool and DtlsHandshakePool threads.
+ */
+class ChannelThread : public Channel::UnixStreamSocket::Forwarder
+{
+public:
+	enum class QueueFullPolicy
+	{
+		// The thread waits for the loop to deliver messages (unless stopping).
+		WAIT = 1,
+		// Messages are dropped (the loop may be waiting for the thread).
+		DROP
+	};
+
+public:
+	ChannelThread(
+	  Channel::UnixStreamSocket* channel, size_t messagesQueueSize, QueueFullPolicy queueFullPolicy);
+	ChannelThread& operator=(const ChannelThread&) = delete;
+	ChannelThread(const ChannelThread&)            = delete;
+	virtual ~ChannelThread();
+
+public:
+	void DeliverMessages();
+
+protected:
+	void Start();
+	void Join();
+
+	/* Pure virtual methods that must be implemented by the subclass. */
+protected:
+	// Called from the thread.
+	virtual void UserOnThread() = 0;
+	// Called from the thread once a message has been queued.
+	virtual void NotifyLoop() = 0;
+
+	/* Pure virtual methods inherited from Channel::UnixStreamSocket::Forwarder. */
+public:
+	void ForwardChannelMessage(const char* nsPayload, size_t nsPayloadLen) override;
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvThread();
+
+protected:
+	std::atomic<bool> stopping{ false };
+
+private:
+	// Passed by argument.
+	Channel::UnixStreamSocket* channel{ nullptr };
+	// Others.
+	QueueFullPolicy queueFullPolicy{ QueueFullPolicy::WAIT };
+	uv_thread_t uvThread;
+	SpscQueue<std::string> messages;
+};
+
+#endif
@@ -3,9 +3,30 @@
 
 #include "common.hpp"
 #include <uv.h>
+#include <atomic>
+#include <vector>
 
 class DepLibUV
 {
+public:
+	/* Struct for the stats of a loop. They are written by the thread running
+	 * the loop and may be read from others. */
+	struct LoopStats
+	{
+		std::atomic<uint64_t> iterations{ 0 };
+		// Time spent running callbacks (not waiting for events).
+		std::atomic<uint64_t> busyTimeNs{ 0 };
+		// Iterations whose callbacks took longer than the stall threshold.
+		std::atomic<uint64_t> stalls{ 0 };
+		std::atomic<uint64_t> stallTimeNs{ 0 };
+		std::atomic<uint64_t> maxIterationTimeNs{ 0 };
+	};
+
+public:
+	// Called once per loop iteration, both before blocking for I/O and right
+	// after processing it.
+	using FlushCallback = void (*)();
+
 public:
 	static void ClassInit();
 	static void ClassDestroy();
@@ -13,9 +34,24 @@ public:
 	static void RunLoop();
 	static uv_loop_t* GetLoop();
 	static uint64_t GetTime();
+	static void AddFlushCallback(FlushCallback callback);
+	static const LoopStats* GetLoopStats();
 
 private:
-	static uv_loop_t* loop;
+	static void WaitForEvents();
+	static void RecordIteration(uint64_t iterationTimeNs);
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnUvLoopIteration();
+
+private:
+	// Each thread running Routers has its own loop.
+	static thread_local uv_loop_t* loop;
+	static thread_local uv_prepare_t* prepareHandle;
+	static thread_local uv_check_t* checkHandle;
+	static thread_local std::vector<FlushCallback> flushCallbacks;
+	static thread_local LoopStats loopStats;
 };
 
 /* Inline static methods. */
@@ -30,4 +66,12 @@ inline uint64_t DepLibUV::GetTime()
 	return uv_now(DepLibUV::loop);
 }
 
+/**
+ * Stats of the loop of the calling thread.
+ */
+inline const DepLibUV::LoopStats* DepLibUV::GetLoopStats()
+{
+	return std::addressof(DepLibUV::loopStats);
+}
+
 #endif
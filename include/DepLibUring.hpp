@@ -0,0 +1,85 @@
+#ifndef MS_DEP_LIBURING_HPP
+#define MS_DEP_LIBURING_HPP
+
+#include "common.hpp"
+#include <uv.h>
+#include <unordered_map>
+#include <vector>
+
+class UdpSocket;
+
+/**
+ * Optional io_uring network engine for UDP sockets (Linux >= 6.0). Datagrams
+ * are received with multishot recvmsg into a provided buffer ring and sent
+ * with sendmsg submissions batched once per loop iteration. Completions are
+ * signaled through an eventfd polled by the libuv loop.
+ */
+class DepLibUring
+{
+private:
+	/* Struct for a datagram being sent by the kernel. */
+	struct SendSlot
+	{
+		// Null if the UdpSocket was closed while the datagram was in flight.
+		UdpSocket* socket{ nullptr };
+		struct msghdr msg;
+		struct iovec iov;
+		struct sockaddr_storage addr;
+		uint8_t store[2048];
+	};
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static bool IsActive();
+	static uint64_t StartRecv(UdpSocket* socket, int fd);
+	static void StopRecv(uint64_t recvId);
+	static bool PrepareSend(
+	  UdpSocket* socket,
+	  int fd,
+	  const uint8_t* data1,
+	  size_t len1,
+	  const uint8_t* data2,
+	  size_t len2,
+	  const struct sockaddr* addr);
+	static void ForgetSends(UdpSocket* socket);
+	static void Submit();
+
+private:
+	static bool Setup();
+	static bool ProbeRecvMultishot();
+	static struct io_uring_sqe* GetSqe();
+	static bool PrepareRecv(int fd, uint64_t recvId);
+	static void ReapCompletions();
+	static void OnRecvCompletion(const struct io_uring_cqe* cqe);
+	static void OnSendCompletion(const struct io_uring_cqe* cqe);
+	static void RecycleBuffer(uint16_t bufferId);
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnUvEventFdReadable();
+	static void OnUvLoopIteration();
+
+private:
+	static thread_local bool active;
+	// False if the kernel rejects multishot recvmsg (UDP sockets use libuv then).
+	static thread_local bool recvSupported;
+	static thread_local int ringFd;
+	static thread_local int eventFd;
+	static thread_local uv_poll_t* uvPollHandle;
+	static thread_local uint64_t nextRecvId;
+	// Map of receive id and the UdpSocket and fd.
+	static thread_local std::unordered_map<uint64_t, std::pair<UdpSocket*, int>> mapRecvIdSocket;
+	static thread_local SendSlot* sendSlots;
+	static thread_local std::vector<uint32_t> freeSendSlots;
+	static thread_local unsigned int pendingSubmissions;
+};
+
+/* Inline static methods. */
+
+inline bool DepLibUring::IsActive()
+{
+	return DepLibUring::active;
+}
+
+#endif
@@ -127,7 +127,7 @@ public:
 	static const int64_t pid;
 	static Channel::UnixStreamSocket* channel;
 	static const size_t bufferSize {10000};
-	static char buffer[];
+	static thread_local char buffer[];
 };
 
 /* Logging macros. */
@@ -9,6 +9,10 @@ class MediaSoupError : public std::runtime_error
 {
 public:
 	explicit MediaSoupError(const char* description);
+
+public:
+	static const size_t bufferSize{ 2000 };
+	static thread_local char buffer[];
 };
 
 /* Inline methods. */
@@ -35,10 +39,8 @@ inline MediaSoupTypeError::MediaSoupTypeError(const char* description) : MediaSo
 	{ \
 		MS_ERROR("throwing MediaSoupError: " desc, ##__VA_ARGS__); \
 		\
-		static char buffer[2000]; \
-		\
-		std::snprintf(buffer, 2000, desc, ##__VA_ARGS__); \
-		throw MediaSoupError(buffer); \
+		std::snprintf(MediaSoupError::buffer, MediaSoupError::bufferSize, desc, ##__VA_ARGS__); \
+		throw MediaSoupError(MediaSoupError::buffer); \
 	} while (false)
 
 #define MS_THROW_ERROR_STD(desc, ...) \
@@ -46,10 +48,8 @@ inline MediaSoupTypeError::MediaSoupTypeError(const char* description) : MediaSo
 	{ \
 		MS_ERROR_STD("throwing MediaSoupError: " desc, ##__VA_ARGS__); \
 		\
-		static char buffer[2000]; \
-		\
-		std::snprintf(buffer, 2000, desc, ##__VA_ARGS__); \
-		throw MediaSoupError(buffer); \
+		std::snprintf(MediaSoupError::buffer, MediaSoupError::bufferSize, desc, ##__VA_ARGS__); \
+		throw MediaSoupError(MediaSoupError::buffer); \
 	} while (false)
 
 #define MS_THROW_TYPE_ERROR(desc, ...) \
@@ -57,10 +57,8 @@ inline MediaSoupTypeError::MediaSoupTypeError(const char* description) : MediaSo
 	{ \
 		MS_ERROR("throwing MediaSoupTypeError: " desc, ##__VA_ARGS__); \
 		\
-		static char buffer[2000]; \
-		\
-		std::snprintf(buffer, 2000, desc, ##__VA_ARGS__); \
-		throw MediaSoupTypeError(buffer); \
+		std::snprintf(MediaSoupError::buffer, MediaSoupError::bufferSize, desc, ##__VA_ARGS__); \
+		throw MediaSoupTypeError(MediaSoupError::buffer); \
 	} while (false)
 
 #define MS_THROW_TYPE_ERROR_STD(desc, ...) \
@@ -68,10 +66,8 @@ inline MediaSoupTypeError::MediaSoupTypeError(const char* description) : MediaSo
 	{ \
 		MS_ERROR_STD("throwing MediaSoupTypeError: " desc, ##__VA_ARGS__); \
 		\
-		static char buffer[2000]; \
-		\
-		std::snprintf(buffer, 2000, desc, ##__VA_ARGS__); \
-		throw MediaSoupTypeError(buffer); \
+		std::snprintf(MediaSoupError::buffer, MediaSoupError::bufferSize, desc, ##__VA_ARGS__); \
+		throw MediaSoupTypeError(MediaSoupError::buffer); \
 	} while (false)
 // clang-format on
 
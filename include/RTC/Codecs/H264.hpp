@@ -12,12 +12,9 @@ namespace RTC
 		class H264
 		{
 		public:
-			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			struct PayloadDescriptor
 			{
-				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
-				~PayloadDescriptor() = default;
-
-				void Dump() const override;
+				void Dump() const;
 
 				// Fields in frame-marking extension.
 				uint8_t s : 1;          // Start of Frame.
@@ -36,9 +33,10 @@ namespace RTC
 			};
 
 		public:
-			static H264::PayloadDescriptor* Parse(
+			static bool Parse(
 			  const uint8_t* data,
 			  size_t len,
+			  PayloadDescriptor& payloadDescriptor,
 			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
 			  uint8_t frameMarkingLen                    = 0);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
@@ -56,22 +54,21 @@ namespace RTC
 			};
 
 		public:
-			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			class PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
-				~PayloadDescriptorHandler() = default;
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 
 			public:
-				void Dump() const override;
-				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
-				void Restore(uint8_t* data) override;
-				uint8_t GetSpatialLayer() const override;
-				uint8_t GetTemporalLayer() const override;
-				bool IsKeyFrame() const override;
+				void Dump() const;
+				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker);
+				void Restore(uint8_t* data);
+				uint8_t GetSpatialLayer() const;
+				uint8_t GetTemporalLayer() const;
+				bool IsKeyFrame() const;
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
 			};
 		};
 
@@ -88,9 +85,15 @@ namespace RTC
 
 		/* Inline PayloadDescriptorHandler methods. */
 
+		inline H264::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const H264::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
+		{
+		}
+
 		inline void H264::PayloadDescriptorHandler::Dump() const
 		{
-			this->payloadDescriptor->Dump();
+			this->payloadDescriptor.Dump();
 		}
 
 		inline uint8_t H264::PayloadDescriptorHandler::GetSpatialLayer() const
@@ -100,12 +103,12 @@ namespace RTC
 
 		inline uint8_t H264::PayloadDescriptorHandler::GetTemporalLayer() const
 		{
-			return this->payloadDescriptor->tid;
+			return this->payloadDescriptor.tid;
 		}
 
 		inline bool H264::PayloadDescriptorHandler::IsKeyFrame() const
 		{
-			return this->payloadDescriptor->isKeyFrame;
+			return this->payloadDescriptor.isKeyFrame;
 		}
 	} // namespace Codecs
 } // namespace RTC
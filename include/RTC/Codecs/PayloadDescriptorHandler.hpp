@@ -2,18 +2,13 @@
 #define MS_RTC_PAYLOAD_DESCRIPTOR_HANDLER_HPP
 
 #include "common.hpp"
+#include <new>         // placement new
+#include <type_traits> // std::is_trivially_destructible
 
 namespace RTC
 {
 	namespace Codecs
 	{
-		// Codec payload descriptor.
-		struct PayloadDescriptor
-		{
-			virtual ~PayloadDescriptor() = default;
-			virtual void Dump() const    = 0;
-		};
-
 		// Encoding context used by PayloadDescriptorHandler to properly rewrite the
 		// PayloadDescriptor.
 		class EncodingContext
@@ -114,19 +109,114 @@ namespace RTC
 			this->currentTemporalLayer = temporalLayer;
 		}
 
+		/**
+		 * Payload descriptor handler of the codec of a RTP packet, held by value in
+		 * the RtpPacket. The codec specific handler (which holds its parsed payload
+		 * descriptor) is constructed in place into an inline buffer and calls are
+		 * dispatched on the codec type, so processing a video packet neither
+		 * allocates memory nor goes through virtual methods.
+		 */
 		class PayloadDescriptorHandler
 		{
 		public:
-			virtual ~PayloadDescriptorHandler() = default;
+			enum class Codec : uint8_t
+			{
+				NONE = 0,
+				VP8,
+				VP9,
+				H264
+			};
 
 		public:
-			virtual void Dump() const                                                                = 0;
-			virtual bool Process(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker) = 0;
-			virtual void Restore(uint8_t* data)                                                      = 0;
-			virtual uint8_t GetSpatialLayer() const                                                  = 0;
-			virtual uint8_t GetTemporalLayer() const                                                 = 0;
-			virtual bool IsKeyFrame() const                                                          = 0;
+			void Dump() const;
+			bool Process(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker);
+			void Restore(uint8_t* data);
+			bool IsSet() const;
+			uint8_t GetSpatialLayer() const;
+			uint8_t GetTemporalLayer() const;
+			bool IsKeyFrame() const;
+			size_t GetNumProcessed() const;
+			size_t GetNumRewrites() const;
+			uint32_t GetPayloadState() const;
+			template<typename T, typename D>
+			T* Set(Codec codec, const D& payloadDescriptor);
+			void Reset();
+
+		private:
+			template<typename T>
+			T* GetHandler();
+			template<typename T>
+			const T* GetHandler() const;
+
+		private:
+			Codec codec{ Codec::NONE };
+			// Values of the codec handler, cached for the getters.
+			uint8_t spatialLayer{ 0u };
+			uint8_t temporalLayer{ 0u };
+			bool keyFrame{ false };
+			// Memory holding the codec specific handler.
+			alignas(8) uint8_t store[32];
 		};
+
+		/* Inline PayloadDescriptorHandler methods. */
+
+		inline bool PayloadDescriptorHandler::IsSet() const
+		{
+			return this->codec != Codec::NONE;
+		}
+
+		inline uint8_t PayloadDescriptorHandler::GetSpatialLayer() const
+		{
+			return this->spatialLayer;
+		}
+
+		inline uint8_t PayloadDescriptorHandler::GetTemporalLayer() const
+		{
+			return this->temporalLayer;
+		}
+
+		inline bool PayloadDescriptorHandler::IsKeyFrame() const
+		{
+			return this->keyFrame;
+		}
+
+		template<typename T, typename D>
+		inline T* PayloadDescriptorHandler::Set(Codec codec, const D& payloadDescriptor)
+		{
+			static_assert(sizeof(T) <= sizeof(this->store), "codec handler does not fit into the store");
+			static_assert(alignof(T) <= 8, "codec handler alignment exceeds the store alignment");
+			static_assert(
+			  std::is_trivially_destructible<T>::value, "codec handler must be trivially destructible");
+
+			auto* handler = new (this->store) T(payloadDescriptor);
+
+			this->codec         = codec;
+			this->spatialLayer  = handler->GetSpatialLayer();
+			this->temporalLayer = handler->GetTemporalLayer();
+			this->keyFrame      = handler->IsKeyFrame();
+
+			return handler;
+		}
+
+		inline void PayloadDescriptorHandler::Reset()
+		{
+			this->codec         = Codec::NONE;
+			this->spatialLayer  = 0u;
+			this->temporalLayer = 0u;
+			this->keyFrame      = false;
+		}
+
+		template<typename T>
+		inline T* PayloadDescriptorHandler::GetHandler()
+		{
+			return reinterpret_cast<T*>(this->store);
+		}
+
+		template<typename T>
+		inline const T* PayloadDescriptorHandler::GetHandler() const
+		{
+			return reinterpret_cast<const T*>(this->store);
+		}
 	} // namespace Codecs
 } // namespace RTC
 
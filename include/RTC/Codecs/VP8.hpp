@@ -36,12 +36,9 @@ namespace RTC
 		class VP8
 		{
 		public:
-			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			struct PayloadDescriptor
 			{
-				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
-				~PayloadDescriptor() = default;
-
-				void Dump() const override;
+				void Dump() const;
 				// Rewrite the buffer with the given pictureId and tl0PictureIndex values.
 				void Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PictureIndex) const;
 				void Restore(uint8_t* data) const;
@@ -72,9 +69,10 @@ namespace RTC
 			};
 
 		public:
-			static VP8::PayloadDescriptor* Parse(
+			static bool Parse(
 			  const uint8_t* data,
 			  size_t len,
+			  PayloadDescriptor& payloadDescriptor,
 			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
 			  uint8_t frameMarkingLen                    = 0);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
@@ -97,22 +95,31 @@ namespace RTC
 			};
 
 		public:
-			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			class PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
-				~PayloadDescriptorHandler() = default;
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 
 			public:
-				void Dump() const override;
-				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
-				void Restore(uint8_t* data) override;
-				uint8_t GetSpatialLayer() const override;
-				uint8_t GetTemporalLayer() const override;
-				bool IsKeyFrame() const override;
+				void Dump() const;
+				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker);
+				void Restore(uint8_t* data);
+				uint8_t GetSpatialLayer() const;
+				uint8_t GetTemporalLayer() const;
+				bool IsKeyFrame() const;
+				size_t GetNumProcessed() const;
+				size_t GetNumRewrites() const;
+				uint32_t GetPayloadState() const;
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
+				// Values currently written into the payload.
+				uint16_t encodedPictureId{ 0u };
+				uint8_t encodedTl0PictureIndex{ 0u };
+				// Number of consumers that processed the payload and number of times the
+				// payload has been actually rewritten for them.
+				uint16_t numProcessed{ 0u };
+				uint16_t numRewrites{ 0u };
 			};
 		};
 
@@ -130,9 +137,16 @@ namespace RTC
 
 		/* Inline PayloadDescriptorHandler methods. */
 
+		inline VP8::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const VP8::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor), encodedPictureId(payloadDescriptor.pictureId),
+		    encodedTl0PictureIndex(payloadDescriptor.tl0PictureIndex)
+		{
+		}
+
 		inline void VP8::PayloadDescriptorHandler::Dump() const
 		{
-			this->payloadDescriptor->Dump();
+			this->payloadDescriptor.Dump();
 		}
 
 		inline uint8_t VP8::PayloadDescriptorHandler::GetSpatialLayer() const
@@ -142,12 +156,27 @@ namespace RTC
 
 		inline uint8_t VP8::PayloadDescriptorHandler::GetTemporalLayer() const
 		{
-			return this->payloadDescriptor->hasTlIndex ? this->payloadDescriptor->tlIndex : 0u;
+			return this->payloadDescriptor.hasTlIndex ? this->payloadDescriptor.tlIndex : 0u;
 		}
 
 		inline bool VP8::PayloadDescriptorHandler::IsKeyFrame() const
 		{
-			return this->payloadDescriptor->isKeyFrame;
+			return this->payloadDescriptor.isKeyFrame;
+		}
+
+		inline size_t VP8::PayloadDescriptorHandler::GetNumProcessed() const
+		{
+			return this->numProcessed;
+		}
+
+		inline size_t VP8::PayloadDescriptorHandler::GetNumRewrites() const
+		{
+			return this->numRewrites;
+		}
+
+		inline uint32_t VP8::PayloadDescriptorHandler::GetPayloadState() const
+		{
+			return (uint32_t{ this->encodedPictureId } << 8) | this->encodedTl0PictureIndex;
 		}
 	} // namespace Codecs
 } // namespace RTC
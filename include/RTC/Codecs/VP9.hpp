@@ -57,12 +57,9 @@ namespace RTC
 		class VP9
 		{
 		public:
-			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			struct PayloadDescriptor
 			{
-				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
-				~PayloadDescriptor() = default;
-
-				void Dump() const override;
+				void Dump() const;
 
 				// Header.
 				uint8_t i : 1; // I: Picture ID (PID) present.
@@ -90,9 +87,10 @@ namespace RTC
 			};
 
 		public:
-			static VP9::PayloadDescriptor* Parse(
+			static bool Parse(
 			  const uint8_t* data,
 			  size_t len,
+			  PayloadDescriptor& payloadDescriptor,
 			  RTC::RtpPacket::FrameMarking* frameMarking = nullptr,
 			  uint8_t frameMarkingLen                    = 0);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
@@ -113,22 +111,21 @@ namespace RTC
 				bool syncRequired{ false };
 			};
 
-			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			class PayloadDescriptorHandler
 			{
 			public:
-				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
-				~PayloadDescriptorHandler() = default;
+				explicit PayloadDescriptorHandler(const PayloadDescriptor& payloadDescriptor);
 
 			public:
-				void Dump() const override;
-				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker) override;
-				void Restore(uint8_t* data) override;
-				uint8_t GetSpatialLayer() const override;
-				uint8_t GetTemporalLayer() const override;
-				bool IsKeyFrame() const override;
+				void Dump() const;
+				bool Process(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker);
+				void Restore(uint8_t* data);
+				uint8_t GetSpatialLayer() const;
+				uint8_t GetTemporalLayer() const;
+				bool IsKeyFrame() const;
 
 			private:
-				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+				PayloadDescriptor payloadDescriptor;
 			};
 		};
 
@@ -146,24 +143,30 @@ namespace RTC
 
 		/* Inline PayloadDescriptorHandler methods. */
 
+		inline VP9::PayloadDescriptorHandler::PayloadDescriptorHandler(
+		  const VP9::PayloadDescriptor& payloadDescriptor)
+		  : payloadDescriptor(payloadDescriptor)
+		{
+		}
+
 		inline void VP9::PayloadDescriptorHandler::Dump() const
 		{
-			this->payloadDescriptor->Dump();
+			this->payloadDescriptor.Dump();
 		}
 
 		inline uint8_t VP9::PayloadDescriptorHandler::GetSpatialLayer() const
 		{
-			return this->payloadDescriptor->hasSlIndex ? this->payloadDescriptor->slIndex : 0u;
+			return this->payloadDescriptor.hasSlIndex ? this->payloadDescriptor.slIndex : 0u;
 		}
 
 		inline uint8_t VP9::PayloadDescriptorHandler::GetTemporalLayer() const
 		{
-			return this->payloadDescriptor->hasTlIndex ? this->payloadDescriptor->tlIndex : 0u;
+			return this->payloadDescriptor.hasTlIndex ? this->payloadDescriptor.tlIndex : 0u;
 		}
 
 		inline bool VP9::PayloadDescriptorHandler::IsKeyFrame() const
 		{
-			return this->payloadDescriptor->isKeyFrame;
+			return this->payloadDescriptor.isKeyFrame;
 		}
 	} // namespace Codecs
 } // namespace RTC
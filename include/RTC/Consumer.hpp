@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "json.hpp"
 #include "Channel/Request.hpp"
+#include "RTC/EgressRtpPacket.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/FeedbackPs.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
@@ -25,7 +26,8 @@ namespace RTC
 		class Listener
 		{
 		public:
-			virtual void OnConsumerSendRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet) = 0;
+			virtual void OnConsumerSendRtpPacket(
+			  RTC::Consumer* consumer, const RTC::EgressRtpPacket& egressPacket) = 0;
 			virtual void OnConsumerRetransmitRtpPacket(
 			  RTC::Consumer* consumer, RTC::RtpPacket* packet, bool probation = false)             = 0;
 			virtual void OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc) = 0;
@@ -0,0 +1,72 @@
+#ifndef MS_RTC_DTLS_HANDSHAKE_POOL_HPP
+#define MS_RTC_DTLS_HANDSHAKE_POOL_HPP
+
+#include "common.hpp"
+#include "ChannelThread.hpp"
+#include "SpscQueue.hpp"
+#include "RTC/DtlsTransport.hpp"
+#include <uv.h>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Pool of threads feeding the DTLS data received during handshakes to the
+	 * SSL objects of the DtlsTransports of the libuv loop that owns it, so
+	 * ECDHE and signatures do not stall the loop. Jobs are handed back to the
+	 * loop once processed, and logs generated by the threads are delivered to
+	 * the Channel by the loop.
+	 */
+	class DtlsHandshakePool
+	{
+	public:
+		class HandshakeThread : public ChannelThread
+		{
+		public:
+			explicit HandshakeThread(uv_async_t* uvHandle);
+			~HandshakeThread() override;
+
+		public:
+			void Submit(RTC::DtlsTransport::HandshakeJob* job);
+			void DeliverJobs();
+
+			/* Pure virtual methods inherited from ChannelThread. */
+		protected:
+			void UserOnThread() override;
+			void NotifyLoop() override;
+
+		private:
+			// Passed by argument.
+			uv_async_t* uvHandle{ nullptr };
+			// Others.
+			uv_sem_t sem;
+			SpscQueue<RTC::DtlsTransport::HandshakeJob*> jobs;
+			SpscQueue<RTC::DtlsTransport::HandshakeJob*> doneJobs;
+		};
+
+	public:
+		static void ClassInit();
+		static void ClassDestroy();
+		static bool IsEnabled();
+		static void Submit(RTC::DtlsTransport::HandshakeJob* job);
+
+		/* Callbacks fired by UV events. */
+	public:
+		static void OnUvJobsDone();
+
+	private:
+		// Each loop has its own pool.
+		static thread_local uv_async_t* uvHandle;
+		static thread_local std::vector<HandshakeThread*> threads;
+		static thread_local size_t nextThreadIdx;
+	};
+
+	/* Inline static methods. */
+
+	inline bool DtlsHandshakePool::IsEnabled()
+	{
+		return !DtlsHandshakePool::threads.empty();
+	}
+} // namespace RTC
+
+#endif
@@ -7,7 +7,10 @@
 #include <openssl/bio.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -52,6 +55,22 @@ namespace RTC
 			std::string value;
 		};
 
+	public:
+		/* Struct for DTLS data given to the SSL object in a DtlsHandshakePool thread. */
+		struct HandshakeJob
+		{
+			// Null if the DtlsTransport was closed while the job was in flight.
+			DtlsTransport* transport{ nullptr };
+			// Received DTLS data, replaced with the application data read (if any).
+			std::string data;
+			int read{ 0 };
+			int sslError{ 0 };
+			// Set by the pool thread once the data has been processed.
+			bool done{ false };
+			std::mutex mutex;
+			std::condition_variable doneCond;
+		};
+
 	private:
 		struct SrtpProfileMapEntry
 		{
@@ -98,6 +117,8 @@ namespace RTC
 		static FingerprintAlgorithm GetFingerprintAlgorithm(const std::string& fingerprint);
 		static std::string& GetFingerprintAlgorithmString(FingerprintAlgorithm fingerprint);
 		static bool IsDtls(const uint8_t* data, size_t len);
+		static void RunHandshakeJob(HandshakeJob* job);
+		static void OnHandshakeJobDone(HandshakeJob* job);
 
 	private:
 		static void GenerateCertificateAndPrivateKey();
@@ -109,7 +130,7 @@ namespace RTC
 		static X509* certificate;
 		static EVP_PKEY* privateKey;
 		static SSL_CTX* sslCtx;
-		static uint8_t sslReadBuffer[];
+		static thread_local uint8_t sslReadBuffer[];
 		static std::map<std::string, Role> string2Role;
 		static std::map<std::string, FingerprintAlgorithm> string2FingerprintAlgorithm;
 		static std::map<FingerprintAlgorithm, std::string> fingerprintAlgorithm2String;
@@ -133,7 +154,11 @@ namespace RTC
 	private:
 		bool IsRunning() const;
 		void Reset();
-		bool CheckStatus(int returnCode);
+		int ReadDtlsData(const uint8_t* data, size_t len);
+		int GetSslError(int returnCode);
+		void OnDtlsDataRead(int read, int sslError, const uint8_t* readData);
+		bool CheckStatus(int sslError);
+		void WaitForHandshakeJob();
 		void SendPendingOutgoingDtlsData();
 		bool SetTimeout();
 		bool ProcessHandshake();
@@ -164,6 +189,11 @@ namespace RTC
 		bool handshakeDone{ false };
 		bool handshakeDoneNow{ false };
 		std::string remoteCert;
+		// The SSL object belongs to the DtlsHandshakePool while this is set.
+		HandshakeJob* handshakeJob{ nullptr };
+		// DTLS data received while a handshake job is in flight.
+		std::deque<std::string> pendingDtlsData;
+		bool handshakeTimeoutPending{ false };
 	};
 
 	/* Inline static methods. */
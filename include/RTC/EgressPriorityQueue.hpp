@@ -0,0 +1,143 @@
+#ifndef MS_RTC_EGRESS_PRIORITY_QUEUE_HPP
+#define MS_RTC_EGRESS_PRIORITY_QUEUE_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include "handles/Timer.hpp"
+#include <uv.h>
+#include <deque>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Strict priority queue for the already encrypted RTP packets of a transport
+	// while its socket is backlogged or the pacer has no budget. Audio is sent
+	// first and probation packets last. When over budget, lower priority packets
+	// are dropped first. Packets are copied into BufferPool buffers.
+	//
+	// Pacing is a leaky bucket refilled at the pacing bitrate and limited to the
+	// configured burst. Queues waiting for budget are scheduled in a timer wheel
+	// driven by a single Timer shared by every transport. Queues that reached
+	// the per iteration quantum keep an idle handle active so the loop does not
+	// block for I/O before draining them again.
+	class EgressPriorityQueue
+	{
+	public:
+		enum class Priority : uint8_t
+		{
+			AUDIO = 0,
+			VIDEO,
+			RTX,
+			PROBATION
+		};
+
+	public:
+		class Listener
+		{
+		public:
+			virtual bool OnEgressPriorityQueueCanSend(const RTC::EgressPriorityQueue* egressQueue) = 0;
+			virtual void OnEgressPriorityQueueSend(
+			  const RTC::EgressPriorityQueue* egressQueue, const uint8_t* data, size_t len) = 0;
+		};
+
+	private:
+		class Ticker : public Timer::Listener
+		{
+		public:
+			Ticker();
+			~Ticker() override;
+
+		public:
+			void Start();
+			void Stop();
+			bool IsActive() const;
+
+			/* Pure virtual methods inherited from Timer::Listener. */
+		public:
+			void OnTimer(Timer* timer) override;
+
+		private:
+			Timer* timer{ nullptr };
+		};
+
+	private:
+		struct Packet
+		{
+			uint8_t* data;
+			size_t len;
+		};
+
+	private:
+		struct Queue
+		{
+			std::deque<Packet> packets;
+			size_t bytes{ 0 };
+			size_t drops{ 0 };
+		};
+
+	public:
+		static void ClassInit();
+		static void ClassDestroy();
+		static void DrainAll();
+
+	private:
+		static void Schedule(EgressPriorityQueue* egressQueue, uint64_t delay);
+		static void Unschedule(EgressPriorityQueue* egressQueue);
+		static void OnWheelTick();
+
+	private:
+		static thread_local std::vector<EgressPriorityQueue*> pendingQueues;
+		static thread_local std::vector<EgressPriorityQueue*> drainingQueues;
+		static thread_local Ticker* ticker;
+		static thread_local uv_idle_t* idleHandle;
+		static thread_local uint64_t wheelTime;
+		static thread_local size_t numScheduledQueues;
+
+	public:
+		explicit EgressPriorityQueue(Listener* listener);
+		virtual ~EgressPriorityQueue();
+
+	public:
+		void FillJsonStats(json& jsonObject) const;
+		bool IsEmpty() const;
+		void SetPacingBitrate(uint32_t bitrate);
+		bool UsePacingBudget(size_t len);
+		void Push(Priority priority, const uint8_t* data, size_t len);
+		void Clear();
+
+	private:
+		void Drain();
+		void SetPending(bool pending);
+		void RefillPacingBudget();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		Queue queues[4];
+		size_t bytes{ 0 };
+		bool pending{ false };
+		// Whether this is in pendingQueues (or drainingQueues), which may happen
+		// while not pending anymore.
+		bool listed{ false };
+		// Pacing bitrate in bps (0 means no pacing).
+		uint32_t pacingBitrate{ 0 };
+		// Available bytes (may be negative after sending a packet bigger than it).
+		int64_t pacingBudget{ 0 };
+		uint64_t pacingBudgetUpdatedAt{ 0 };
+		// Timer wheel slot (-1 if not scheduled) and position within it.
+		int32_t wheelSlot{ -1 };
+		size_t wheelSlotIdx{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline bool EgressPriorityQueue::IsEmpty() const
+	{
+		return this->bytes == 0;
+	}
+} // namespace RTC
+
+#endif
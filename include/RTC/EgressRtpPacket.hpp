@@ -0,0 +1,120 @@
+#ifndef MS_RTC_EGRESS_RTP_PACKET_HPP
+#define MS_RTC_EGRESS_RTP_PACKET_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <cstring> // std::memcpy()
+
+namespace RTC
+{
+	/**
+	 * Packet sent by a Consumer. It holds the Consumer's own copy of the RTP fixed
+	 * header (with its ssrc, sequence number and timestamp) and references the
+	 * packet being forwarded, which is not modified. The transport assembles the
+	 * fixed header and the rest of the packet when sending or encrypting it.
+	 */
+	class EgressRtpPacket
+	{
+	public:
+		// Size of the RTP fixed header.
+		static constexpr size_t HeaderSize{ 12 };
+
+	public:
+		explicit EgressRtpPacket(RTC::RtpPacket* packet);
+		EgressRtpPacket(RTC::RtpPacket* packet, uint32_t ssrc, uint16_t seq, uint32_t timestamp);
+
+	public:
+		RTC::RtpPacket* GetPacket() const;
+		uint32_t GetSsrc() const;
+		uint16_t GetSequenceNumber() const;
+		uint32_t GetTimestamp() const;
+		size_t GetSize() const;
+		const uint8_t* GetHeader() const;
+		const uint8_t* GetBody() const;
+		size_t GetBodySize() const;
+		void Write(uint8_t* buffer) const;
+
+	private:
+		// Passed by argument.
+		RTC::RtpPacket* packet{ nullptr };
+		// Others.
+		uint32_t ssrc{ 0u };
+		uint16_t seq{ 0u };
+		uint32_t timestamp{ 0u };
+		uint8_t header[HeaderSize];
+	};
+
+	/* Inline instance methods. */
+
+	inline EgressRtpPacket::EgressRtpPacket(RTC::RtpPacket* packet)
+	  : packet(packet), ssrc(packet->GetSsrc()), seq(packet->GetSequenceNumber()),
+	    timestamp(packet->GetTimestamp())
+	{
+		std::memcpy(this->header, packet->GetData(), HeaderSize);
+	}
+
+	inline EgressRtpPacket::EgressRtpPacket(
+	  RTC::RtpPacket* packet, uint32_t ssrc, uint16_t seq, uint32_t timestamp)
+	  : packet(packet), ssrc(ssrc), seq(seq), timestamp(timestamp)
+	{
+		std::memcpy(this->header, packet->GetData(), HeaderSize);
+
+		auto* header = reinterpret_cast<RTC::RtpPacket::Header*>(this->header);
+
+		header->sequenceNumber = uint16_t{ htons(seq) };
+		header->timestamp      = uint32_t{ htonl(timestamp) };
+		header->ssrc           = uint32_t{ htonl(ssrc) };
+	}
+
+	inline RTC::RtpPacket* EgressRtpPacket::GetPacket() const
+	{
+		return this->packet;
+	}
+
+	inline uint32_t EgressRtpPacket::GetSsrc() const
+	{
+		return this->ssrc;
+	}
+
+	inline uint16_t EgressRtpPacket::GetSequenceNumber() const
+	{
+		return this->seq;
+	}
+
+	inline uint32_t EgressRtpPacket::GetTimestamp() const
+	{
+		return this->timestamp;
+	}
+
+	inline size_t EgressRtpPacket::GetSize() const
+	{
+		return this->packet->GetSize();
+	}
+
+	inline const uint8_t* EgressRtpPacket::GetHeader() const
+	{
+		return this->header;
+	}
+
+	inline const uint8_t* EgressRtpPacket::GetBody() const
+	{
+		return this->packet->GetData() + HeaderSize;
+	}
+
+	inline size_t EgressRtpPacket::GetBodySize() const
+	{
+		return this->packet->GetSize() - HeaderSize;
+	}
+
+	/**
+	 * Writes the whole packet into the given buffer, which must have room for
+	 * GetSize() bytes.
+	 */
+	inline void EgressRtpPacket::Write(uint8_t* buffer) const
+	{
+		std::memcpy(buffer, this->header, HeaderSize);
+		std::memcpy(buffer + HeaderSize, GetBody(), GetBodySize());
+	}
+} // namespace RTC
+
+#endif
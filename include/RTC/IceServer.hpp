@@ -33,6 +33,8 @@ namespace RTC
 			 */
 			virtual void OnIceServerSendStunPacket(
 			  const RTC::IceServer* iceServer, const RTC::StunPacket* packet, RTC::TransportTuple* tuple) = 0;
+			virtual void OnIceServerTupleAdded(
+			  const RTC::IceServer* iceServer, RTC::TransportTuple* tuple) = 0;
 			virtual void OnIceServerSelectedTuple(
 			  const RTC::IceServer* iceServer, RTC::TransportTuple* tuple)        = 0;
 			virtual void OnIceServerConnected(const RTC::IceServer* iceServer)    = 0;
@@ -1,13 +1,18 @@
 #ifndef MS_RTC_PIPE_TRANSPORT_HPP
 #define MS_RTC_PIPE_TRANSPORT_HPP
 
+#include "RTC/SharedMemoryPipe.hpp"
 #include "RTC/Transport.hpp"
 #include "RTC/TransportTuple.hpp"
 #include "RTC/UdpSocket.hpp"
+#include <string>
+#include <unordered_map>
 
 namespace RTC
 {
-	class PipeTransport : public RTC::Transport, public RTC::UdpSocket::Listener
+	class PipeTransport : public RTC::Transport,
+	                      public RTC::UdpSocket::Listener,
+	                      public RTC::SharedMemoryPipe::Listener
 	{
 	private:
 		struct ListenIp
@@ -16,6 +21,10 @@ namespace RTC
 			std::string announcedIp;
 		};
 
+	private:
+		// PipeTransports of the Routers running in this thread, by id.
+		static thread_local std::unordered_map<std::string, PipeTransport*> mapIdPipeTransport;
+
 	public:
 		PipeTransport(const std::string& id, RTC::Transport::Listener* listener, json& data);
 		~PipeTransport() override;
@@ -28,7 +37,7 @@ namespace RTC
 	private:
 		bool IsConnected() const override;
 		void SendRtpPacket(
-		  RTC::RtpPacket* packet,
+		  const RTC::EgressRtpPacket& egressPacket,
 		  RTC::Consumer* consumer,
 		  bool retransmitted = false,
 		  bool probation     = false) override;
@@ -38,6 +47,9 @@ namespace RTC
 		void OnRtpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtcpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnSctpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void SendData(const uint8_t* data1, size_t len1, const uint8_t* data2 = nullptr, size_t len2 = 0);
+		void ReceivePipedData(
+		  PipeTransport* pipeTransport, const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2);
 
 		/* Pure virtual methods inherited from RTC::Transport. */
 	private:
@@ -55,11 +67,24 @@ namespace RTC
 		void OnUdpSocketPacketReceived(
 		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
 
+		/* Pure virtual methods inherited from RTC::SharedMemoryPipe::Listener. */
+	public:
+		void OnSharedMemoryPipeConnected(RTC::SharedMemoryPipe* pipe) override;
+		void OnSharedMemoryPipeFailed(RTC::SharedMemoryPipe* pipe) override;
+		void OnSharedMemoryPipePacketReceived(
+		  RTC::SharedMemoryPipe* pipe, const uint8_t* data, size_t len) override;
+
 	private:
 		// Allocated by this.
 		RTC::UdpSocket* udpSocket{ nullptr };
 		RTC::TransportTuple* tuple{ nullptr };
+		RTC::SharedMemoryPipe* sharedMemoryPipe{ nullptr };
+		// Copy of the TRANSPORT_CONNECT request, replied once the remote ring is mapped.
+		Channel::Request* sharedMemoryConnectRequest{ nullptr };
 		// Others.
+		// PipeTransport in this thread that packets are directly given to.
+		PipeTransport* pipedTransport{ nullptr };
+		bool sharedMemoryConnecting{ false };
 		ListenIp listenIp;
 		struct sockaddr_storage remoteAddrStorage;
 	};
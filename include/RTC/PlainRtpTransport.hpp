@@ -28,7 +28,7 @@ namespace RTC
 	private:
 		bool IsConnected() const override;
 		void SendRtpPacket(
-		  RTC::RtpPacket* packet,
+		  const RTC::EgressRtpPacket& egressPacket,
 		  RTC::Consumer* consumer,
 		  bool retransmitted = false,
 		  bool probation     = false) override;
@@ -5,6 +5,7 @@
 #include "Settings.hpp"
 #include "json.hpp"
 #include <uv.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +36,8 @@ namespace RTC
 	private:
 		static std::unordered_map<std::string, std::vector<bool>> mapUdpIpPorts;
 		static std::unordered_map<std::string, std::vector<bool>> mapTcpIpPorts;
+		// Ports are shared by all the threads running Routers.
+		static std::mutex mutex;
 	};
 
 	/* Inline static methods. */
@@ -11,7 +11,7 @@ namespace RTC
 	{
 		// Internal buffer for RTCP serialization.
 		constexpr size_t BufferSize{ 65536 };
-		extern uint8_t Buffer[BufferSize];
+		extern thread_local uint8_t Buffer[BufferSize];
 
 		// Maximum interval for regular RTCP mode.
 		constexpr uint16_t MaxAudioIntervalMs{ 5000 };
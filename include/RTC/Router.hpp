@@ -99,6 +99,9 @@ namespace RTC
 		std::unordered_map<RTC::DataProducer*, std::unordered_set<RTC::DataConsumer*>> mapDataProducerDataConsumers;
 		std::unordered_map<RTC::DataConsumer*, RTC::DataProducer*> mapDataConsumerDataProducer;
 		std::unordered_map<std::string, RTC::DataProducer*> mapDataProducers;
+		// Number of payload rewrites requested by Consumers and actually done.
+		size_t numPayloadProcessed{ 0u };
+		size_t numPayloadRewrites{ 0u };
 	};
 } // namespace RTC
 
@@ -4,7 +4,6 @@
 #include "common.hpp"
 #include "Utils.hpp"
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
-#include <map>
 #include <string>
 #include <vector>
 
@@ -15,6 +14,8 @@ namespace RTC
 	// Max MTU size.
 	constexpr size_t MtuSize{ 1500 };
 
+	class SharedRtpPacket;
+
 	class RtpPacket
 	{
 	public:
@@ -110,6 +111,9 @@ namespace RTC
 	public:
 		static bool IsRtp(const uint8_t* data, size_t len);
 		static RtpPacket* Parse(const uint8_t* data, size_t len);
+		static void ClassDestroy();
+		static void* operator new(size_t size);
+		static void operator delete(void* ptr, size_t size);
 
 	private:
 		RtpPacket(
@@ -169,10 +173,19 @@ namespace RTC
 		RtpPacket* Clone(const uint8_t* buffer) const;
 		void RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq);
 		bool RtxDecode(uint8_t payloadType, uint32_t ssrc);
-		void SetPayloadDescriptorHandler(RTC::Codecs::PayloadDescriptorHandler* payloadDescriptorHandler);
+		template<typename T, typename D>
+		void SetPayloadDescriptorHandler(
+		  RTC::Codecs::PayloadDescriptorHandler::Codec codec, const D& payloadDescriptor);
 		bool ProcessPayload(RTC::Codecs::EncodingContext* context);
 		void RestorePayload();
+		size_t GetNumPayloadProcessed() const;
+		size_t GetNumPayloadRewrites() const;
+		uint32_t GetPayloadState() const;
 		void ShiftPayload(size_t payloadOffset, size_t shift, bool expand = true);
+		RTC::SharedRtpPacket* GetSharedPacket() const;
+		size_t GetTailroom() const;
+		void SetBufferLength(size_t bufferLength);
+		void SetSharedPacket(RTC::SharedRtpPacket* sharedPacket);
 
 	private:
 		void ParseExtensions();
@@ -182,8 +195,11 @@ namespace RTC
 		Header* header{ nullptr };
 		uint8_t* csrcList{ nullptr };
 		HeaderExtension* headerExtension{ nullptr };
-		std::map<uint8_t, OneByteExtension*> mapOneByteExtensions;
-		std::map<uint8_t, TwoBytesExtension*> mapTwoBytesExtensions;
+		// One-Byte and Two-Bytes extension elements indexed by id. Only the table
+		// matching the current header extension type is valid, so the other one is
+		// not cleared.
+		OneByteExtension* oneByteExtensions[15];
+		TwoBytesExtension* twoBytesExtensions[256];
 		uint8_t midExtensionId{ 0 };
 		uint8_t ridExtensionId{ 0 };
 		uint8_t rridExtensionId{ 0 };
@@ -196,8 +212,12 @@ namespace RTC
 		size_t payloadLength{ 0 };
 		uint8_t payloadPadding{ 0 };
 		size_t size{ 0 }; // Full size of the packet in bytes.
+		// Length of the memory holding the packet if owned by the caller (0 otherwise).
+		size_t bufferLength{ 0 };
 		// Codecs
-		std::unique_ptr<Codecs::PayloadDescriptorHandler> payloadDescriptorHandler;
+		Codecs::PayloadDescriptorHandler payloadDescriptorHandler;
+		// Copy of this packet shared by the retransmission buffers of consumers.
+		RTC::SharedRtpPacket* sharedPacket{ nullptr };
 	};
 
 	/* Inline static methods. */
@@ -519,12 +539,13 @@ namespace RTC
 		}
 		else if (HasOneByteExtensions())
 		{
-			auto it = this->mapOneByteExtensions.find(id);
-
-			if (it == this->mapOneByteExtensions.end())
+			if (id > 14)
 				return nullptr;
 
-			auto* extension = it->second;
+			auto* extension = this->oneByteExtensions[id];
+
+			if (!extension)
+				return nullptr;
 
 			len = extension->len + 1;
 
@@ -532,13 +553,11 @@ namespace RTC
 		}
 		else if (HasTwoBytesExtensions())
 		{
-			auto it = this->mapTwoBytesExtensions.find(id);
+			auto* extension = this->twoBytesExtensions[id];
 
-			if (it == this->mapTwoBytesExtensions.end())
+			if (!extension)
 				return nullptr;
 
-			auto* extension = it->second;
-
 			len = extension->len;
 
 			// In Two-Byte extensions value length may be zero. If so, return nullptr.
@@ -570,32 +589,61 @@ namespace RTC
 
 	inline uint8_t RtpPacket::GetSpatialLayer() const
 	{
-		if (!this->payloadDescriptorHandler)
-			return 0u;
-
-		return this->payloadDescriptorHandler->GetSpatialLayer();
+		return this->payloadDescriptorHandler.GetSpatialLayer();
 	}
 
 	inline uint8_t RtpPacket::GetTemporalLayer() const
 	{
-		if (!this->payloadDescriptorHandler)
-			return 0u;
-
-		return this->payloadDescriptorHandler->GetTemporalLayer();
+		return this->payloadDescriptorHandler.GetTemporalLayer();
 	}
 
 	inline bool RtpPacket::IsKeyFrame() const
 	{
-		if (!this->payloadDescriptorHandler)
-			return false;
+		return this->payloadDescriptorHandler.IsKeyFrame();
+	}
 
-		return this->payloadDescriptorHandler->IsKeyFrame();
+	inline size_t RtpPacket::GetNumPayloadProcessed() const
+	{
+		return this->payloadDescriptorHandler.GetNumProcessed();
+	}
+
+	inline size_t RtpPacket::GetNumPayloadRewrites() const
+	{
+		return this->payloadDescriptorHandler.GetNumRewrites();
 	}
 
+	inline uint32_t RtpPacket::GetPayloadState() const
+	{
+		return this->payloadDescriptorHandler.GetPayloadState();
+	}
+
+	template<typename T, typename D>
 	inline void RtpPacket::SetPayloadDescriptorHandler(
-	  RTC::Codecs::PayloadDescriptorHandler* payloadDescriptorHandler)
+	  RTC::Codecs::PayloadDescriptorHandler::Codec codec, const D& payloadDescriptor)
+	{
+		this->payloadDescriptorHandler.Set<T>(codec, payloadDescriptor);
+	}
+
+	inline RTC::SharedRtpPacket* RtpPacket::GetSharedPacket() const
+	{
+		return this->sharedPacket;
+	}
+
+	/**
+	 * Writable bytes after the end of the packet. Only packets whose buffer
+	 * length was set have tailroom.
+	 */
+	inline size_t RtpPacket::GetTailroom() const
+	{
+		if (this->bufferLength <= this->size)
+			return 0u;
+
+		return this->bufferLength - this->size;
+	}
+
+	inline void RtpPacket::SetBufferLength(size_t bufferLength)
 	{
-		this->payloadDescriptorHandler.reset(payloadDescriptorHandler);
+		this->bufferLength = bufferLength;
 	}
 } // namespace RTC
 
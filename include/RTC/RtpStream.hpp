@@ -86,7 +86,8 @@ namespace RTC
 		uint8_t GetScore() const;
 
 	protected:
-		bool UpdateSeq(RTC::RtpPacket* packet);
+		bool ReceiveSeq(uint32_t ssrc, uint16_t seq, uint32_t timestamp);
+		bool UpdateSeq(uint32_t ssrc, uint16_t seq, uint32_t timestamp);
 		void UpdateScore(uint8_t score);
 		void PacketRetransmitted(RTC::RtpPacket* packet);
 		void PacketRepaired(RTC::RtpPacket* packet);
@@ -2,8 +2,10 @@
 #define MS_RTC_RTP_STREAM_SEND_HPP
 
 #include "Utils.hpp"
+#include "RTC/EgressRtpPacket.hpp"
 #include "RTC/RateCalculator.hpp"
 #include "RTC/RtpStream.hpp"
+#include "RTC/SharedRtpPacket.hpp"
 #include <vector>
 
 namespace RTC
@@ -21,16 +23,15 @@ namespace RTC
 	public:
 		struct StorageItem
 		{
-			// Cloned packet.
-			RTC::RtpPacket* packet{ nullptr };
-			// Memory to hold the cloned packet (with extra space for RTX encoding).
-			uint8_t store[RTC::MtuSize + 100];
+			// Packet content (shared with other consumers of the same stream).
+			RTC::SharedRtpPacket* sharedPacket{ nullptr };
+			// Sequence number and timestamp of the packet as sent by this stream.
+			uint16_t seq{ 0 };
+			uint32_t timestamp{ 0 };
 			// Last time this packet was resent.
 			uint64_t resentAtTime{ 0 };
 			// Number of times this packet was resent.
 			uint8_t sentTimes{ 0 };
-			// Whether the packet has been already RTX encoded.
-			bool rtxEncoded{ false };
 		};
 
 	public:
@@ -41,6 +42,7 @@ namespace RTC
 		void FillJsonStats(json& jsonObject) override;
 		void SetRtx(uint8_t payloadType, uint32_t ssrc) override;
 		bool ReceivePacket(RTC::RtpPacket* packet) override;
+		bool ReceivePacket(const RTC::EgressRtpPacket& egressPacket);
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket);
 		void ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType);
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
@@ -55,20 +57,20 @@ namespace RTC
 		uint32_t GetLayerBitrate(uint64_t now, uint8_t spatialLayer, uint8_t temporalLayer) override;
 
 	private:
-		void StorePacket(RTC::RtpPacket* packet);
+		void StorePacket(const RTC::EgressRtpPacket& egressPacket);
+		StorageItem* GetStorageItem(uint16_t seq);
 		void ClearBuffer();
 		void ResetStorageItem(StorageItem* storageItem);
-		void UpdateBufferStartIdx();
 		void FillRetransmissionContainer(uint16_t seq, uint16_t bitmask);
+		RTC::RtpPacket* CloneStoredPacket(StorageItem* storageItem, uint16_t seq, uint8_t* buffer);
 		void UpdateScore(RTC::RTCP::ReceiverReport* report);
 
 	private:
 		uint32_t lostPrior{ 0 }; // Packets lost at last interval.
 		uint32_t sentPrior{ 0 }; // Packets sent at last interval.
-		std::vector<StorageItem*> buffer;
-		uint16_t bufferStartIdx{ 0 };
-		size_t bufferSize{ 0 };
-		std::vector<StorageItem> storage;
+		// Ring of stored packets indexed by seq & bufferMask.
+		std::vector<StorageItem> buffer;
+		uint16_t bufferMask{ 0 };
 		float rtt{ 0 };
 		uint16_t rtxSeq{ 0 };
 		RTC::RtpDataCounter transmissionCounter;
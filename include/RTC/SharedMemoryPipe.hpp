@@ -0,0 +1,98 @@
+#ifndef MS_RTC_SHARED_MEMORY_PIPE_HPP
+#define MS_RTC_SHARED_MEMORY_PIPE_HPP
+
+#include "common.hpp"
+#include <uv.h>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Pipe between two workers of the same host made of a ring per direction in
+	 * shared memory (memfd). Each side owns the ring it reads from, along with
+	 * the eventfd used to wake it up, and hands both to the other side through a
+	 * Unix socket in the abstract namespace. Once connected, frames are
+	 * exchanged with no syscalls but the eventfd wakeups, which are coalesced
+	 * once per loop iteration and skipped while the reader has not drained the
+	 * ring yet. Linux only.
+	 */
+	class SharedMemoryPipe
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual void OnSharedMemoryPipeConnected(RTC::SharedMemoryPipe* pipe) = 0;
+			virtual void OnSharedMemoryPipeFailed(RTC::SharedMemoryPipe* pipe) = 0;
+			virtual void OnSharedMemoryPipePacketReceived(
+			  RTC::SharedMemoryPipe* pipe, const uint8_t* data, size_t len) = 0;
+		};
+
+	public:
+		static void ClassInit();
+		static void FlushAll();
+
+	private:
+		// Pipes with frames written since the last wakeup of their peers.
+		static thread_local std::vector<SharedMemoryPipe*> pendingPipes;
+
+	public:
+		SharedMemoryPipe(Listener* listener, const std::string& id);
+		~SharedMemoryPipe();
+
+	public:
+		const std::string& GetName() const;
+		bool IsConnected() const;
+		void Connect(const std::string& name);
+		bool Send(const uint8_t* data1, size_t len1, const uint8_t* data2 = nullptr, size_t len2 = 0);
+
+	private:
+		void Close();
+		void WakeUpRemote();
+		void ReadLocalRing();
+		void CloseCorrupted();
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvListenReadable();
+		void OnUvConnectReadable();
+		void OnUvEventFdReadable();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		uv_poll_t* listenUvHandle{ nullptr };
+		uv_poll_t* connectUvHandle{ nullptr };
+		uv_poll_t* eventUvHandle{ nullptr };
+		// Others.
+		std::string name;
+		// Pid of the worker we connect to, the only one allowed to connect to us.
+		int64_t remotePid{ -1 };
+		int listenFd{ -1 };
+		int connectFd{ -1 };
+		// Ring we read from (written by the remote side).
+		int localMemFd{ -1 };
+		int localEventFd{ -1 };
+		uint8_t* localRing{ nullptr };
+		// Ring we write into (read by the remote side).
+		int remoteEventFd{ -1 };
+		uint8_t* remoteRing{ nullptr };
+		bool wakeUpPending{ false };
+	};
+
+	/* Inline instance methods. */
+
+	inline const std::string& SharedMemoryPipe::GetName() const
+	{
+		return this->name;
+	}
+
+	inline bool SharedMemoryPipe::IsConnected() const
+	{
+		return this->remoteRing != nullptr;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef MS_RTC_SHARED_RTP_PACKET_HPP
+#define MS_RTC_SHARED_RTP_PACKET_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Reference counted copy of a forwarded RTP packet. All the consumers of the
+	 * same producer stream which forward an identical packet keep a reference to
+	 * a single instance in their retransmission buffers. Each consumer stores its
+	 * own rewritten ssrc, sequence number and timestamp and applies them when
+	 * retransmitting.
+	 */
+	class SharedRtpPacket
+	{
+	public:
+		static SharedRtpPacket* Create(const RTC::RtpPacket* packet);
+		static void ClassDestroy();
+
+	private:
+		SharedRtpPacket() = default;
+
+	public:
+		void AddRef();
+		void Release();
+		const RTC::RtpPacket* GetPacket() const;
+		bool Matches(const RTC::RtpPacket* packet) const;
+		RTC::RtpPacket* Clone(uint8_t* buffer) const;
+
+	private:
+		// Allocated by this.
+		RTC::RtpPacket* packet{ nullptr };
+		// Others.
+		size_t refCount{ 0 };
+		// Payload state of the packet when copied (see RtpPacket::GetPayloadState()).
+		uint32_t payloadState{ 0 };
+		// Memory to hold the cloned packet.
+		uint8_t store[RTC::MtuSize];
+	};
+
+	/* Inline instance methods. */
+
+	inline void SharedRtpPacket::AddRef()
+	{
+		++this->refCount;
+	}
+
+	inline const RTC::RtpPacket* SharedRtpPacket::GetPacket() const
+	{
+		return this->packet;
+	}
+
+	inline RTC::RtpPacket* SharedRtpPacket::Clone(uint8_t* buffer) const
+	{
+		return this->packet->Clone(buffer);
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef MS_RTC_SHARED_TCP_SERVER_HPP
+#define MS_RTC_SHARED_TCP_SERVER_HPP
+
+#include "common.hpp"
+#include "RTC/TcpConnection.hpp"
+#include "RTC/TcpServer.hpp"
+#include "handles/Timer.hpp"
+#include <string>
+#include <unordered_map>
+
+namespace RTC
+{
+	/**
+	 * Worker wide ICE-TCP listener shared by all the WebRtcTransports listening
+	 * in the same IP. Each accepted connection is handed to the transport whose
+	 * local ICE usernameFragment matches the USERNAME attribute of the first
+	 * STUN Binding Request received in it (RFC 4571 framed). Connections whose
+	 * first frame is not such a request, or that do not send it in time, are
+	 * closed.
+	 */
+	class SharedTcpServer : public RTC::TcpServer::Listener,
+	                        public RTC::TcpConnection::Listener,
+	                        public Timer::Listener
+	{
+	private:
+		struct TransportListeners
+		{
+			RTC::TcpServer::Listener* listener;
+			RTC::TcpConnection::Listener* connListener;
+		};
+
+	public:
+		static SharedTcpServer* Acquire(std::string& ip);
+		static void Release(SharedTcpServer* sharedTcpServer);
+
+	private:
+		// Servers belong to the loop of a thread so each thread has its own ones.
+		static thread_local std::unordered_map<std::string, SharedTcpServer*> mapIpSharedTcpServers;
+
+	private:
+		explicit SharedTcpServer(std::string& ip);
+		virtual ~SharedTcpServer();
+
+	public:
+		RTC::TcpServer* GetTcpServer() const;
+		void AddUsernameFragment(
+		  const std::string& usernameFragment,
+		  RTC::TcpServer::Listener* listener,
+		  RTC::TcpConnection::Listener* connListener);
+		void RemoveListener(RTC::TcpServer::Listener* listener);
+
+	private:
+		void RejectConnection(RTC::TcpConnection* connection);
+
+		/* Pure virtual methods inherited from RTC::TcpServer::Listener. */
+	public:
+		void OnRtcTcpConnectionAccepted(
+		  RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) override;
+		void OnRtcTcpConnectionClosed(RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) override;
+
+		/* Pure virtual methods inherited from RTC::TcpConnection::Listener. */
+	public:
+		void OnTcpConnectionPacketReceived(
+		  RTC::TcpConnection* connection, const uint8_t* data, size_t len) override;
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Allocated by this.
+		RTC::TcpServer* tcpServer{ nullptr };
+		Timer* unboundTimer{ nullptr };
+		// Others.
+		std::string ip;
+		size_t refCount{ 0 };
+		std::unordered_map<std::string, TransportListeners> mapUsernameFragmentListeners;
+		std::unordered_map<RTC::TcpConnection*, TransportListeners> mapConnectionListeners;
+		// Not yet bound connections and the time they were accepted at.
+		std::unordered_map<RTC::TcpConnection*, uint64_t> mapUnboundConnectionTimes;
+	};
+
+	/* Inline instance methods. */
+
+	inline RTC::TcpServer* SharedTcpServer::GetTcpServer() const
+	{
+		return this->tcpServer;
+	}
+} // namespace RTC
+
+#endif
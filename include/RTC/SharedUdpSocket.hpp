@@ -0,0 +1,88 @@
+#ifndef MS_RTC_SHARED_UDP_SOCKET_HPP
+#define MS_RTC_SHARED_UDP_SOCKET_HPP
+
+#include "common.hpp"
+#include "RTC/TransportTuple.hpp"
+#include "RTC/UdpSocket.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Worker wide UDP socket shared by all the WebRtcTransports listening in the
+	 * same IP. STUN Binding Requests are demultiplexed by the local ICE
+	 * usernameFragment in their USERNAME attribute, and the rest of packets by
+	 * remote address once the transport has authenticated it.
+	 */
+	class SharedUdpSocket : public RTC::UdpSocket::Listener
+	{
+	private:
+		struct AddressKey
+		{
+			uint8_t ip[16];
+			uint16_t port;
+			uint8_t family;
+
+			bool operator==(const AddressKey& other) const;
+		};
+
+		struct AddressKeyHash
+		{
+			size_t operator()(const AddressKey& key) const;
+		};
+
+		/* Struct for the map entries of a listener (so they are removed at once). */
+		struct ListenerKeys
+		{
+			std::vector<std::string> usernameFragments;
+			std::vector<AddressKey> addresses;
+		};
+
+	public:
+		static SharedUdpSocket* Acquire(std::string& ip);
+		static void Release(SharedUdpSocket* sharedUdpSocket);
+
+	private:
+		static AddressKey GetAddressKey(const struct sockaddr* addr);
+
+	private:
+		// Sockets belong to the loop of a thread so each thread has its own ones.
+		static thread_local std::unordered_map<std::string, SharedUdpSocket*> mapIpSharedUdpSockets;
+
+	private:
+		explicit SharedUdpSocket(std::string& ip);
+		virtual ~SharedUdpSocket();
+
+	public:
+		RTC::UdpSocket* GetUdpSocket() const;
+		void AddUsernameFragment(const std::string& usernameFragment, RTC::UdpSocket::Listener* listener);
+		void AddRemoteAddress(const RTC::TransportTuple* tuple, RTC::UdpSocket::Listener* listener);
+		void RemoveListener(RTC::UdpSocket::Listener* listener);
+
+		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
+	public:
+		void OnUdpSocketPacketReceived(
+		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
+
+	private:
+		// Allocated by this.
+		RTC::UdpSocket* udpSocket{ nullptr };
+		// Others.
+		std::string ip;
+		size_t refCount{ 0 };
+		std::unordered_map<std::string, RTC::UdpSocket::Listener*> mapUsernameFragmentListener;
+		std::unordered_map<AddressKey, RTC::UdpSocket::Listener*, AddressKeyHash> mapAddressListener;
+		std::unordered_map<RTC::UdpSocket::Listener*, ListenerKeys> mapListenerKeys;
+	};
+
+	/* Inline instance methods. */
+
+	inline RTC::UdpSocket* SharedUdpSocket::GetUdpSocket() const
+	{
+		return this->udpSocket;
+	}
+} // namespace RTC
+
+#endif
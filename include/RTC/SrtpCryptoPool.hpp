@@ -0,0 +1,106 @@
+#ifndef MS_RTC_SRTP_CRYPTO_POOL_HPP
+#define MS_RTC_SRTP_CRYPTO_POOL_HPP
+
+#include "common.hpp"
+#include "ChannelThread.hpp"
+#include "SpscQueue.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <uv.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Pool of threads encrypting and decrypting batches of RTP packets for the
+	 * libuv loop that owns it. Each thread has its own queue of batches, so
+	 * batches given to the same thread are processed in order, and processed
+	 * batches are handed back to the loop in the order they were submitted.
+	 * Logs generated by the threads are delivered to the Channel by the loop.
+	 */
+	class SrtpCryptoPool
+	{
+	public:
+		/* Struct for a batch of packets submitted to the pool. */
+		struct Batch
+		{
+			std::vector<RTC::SrtpSession::RtpBatchItem> items;
+			size_t count{ 0 };
+			// Set by the pool thread once the items have been processed.
+			std::atomic<bool> done{ false };
+		};
+
+		using BatchDoneCallback = void (*)(Batch* batch);
+
+	public:
+		class CryptoThread : public ChannelThread
+		{
+		public:
+			explicit CryptoThread(SrtpCryptoPool* pool);
+			~CryptoThread() override;
+
+		public:
+			void Submit(Batch* batch);
+
+			/* Pure virtual methods inherited from ChannelThread. */
+		protected:
+			void UserOnThread() override;
+			void NotifyLoop() override;
+
+		private:
+			// Passed by argument.
+			SrtpCryptoPool* pool{ nullptr };
+			// Others.
+			uv_sem_t sem;
+			SpscQueue<Batch*> batches;
+		};
+
+	public:
+		SrtpCryptoPool(size_t numThreads, BatchDoneCallback callback);
+		~SrtpCryptoPool();
+
+	public:
+		size_t GetNumThreads() const;
+		void Submit(Batch* batch, size_t threadIdx);
+		void Wait() const;
+		const std::deque<Batch*>& GetPendingBatches() const;
+
+	private:
+		void NotifyLoop();
+		void SetBatchDone(Batch* batch);
+
+		/* Callbacks fired by UV events. */
+	public:
+		void OnUvBatchesDone();
+
+	private:
+		// Passed by argument.
+		BatchDoneCallback callback{ nullptr };
+		// Allocated by this.
+		uv_async_t* uvHandle{ nullptr };
+		std::vector<CryptoThread*> threads;
+		// Others.
+		// Batches submitted and not handed back yet, in submission order.
+		std::deque<Batch*> pendingBatches;
+		// Signaled when a batch is done, for Wait().
+		mutable std::mutex doneMutex;
+		mutable std::condition_variable doneCond;
+	};
+
+	/* Inline instance methods. */
+
+	inline size_t SrtpCryptoPool::GetNumThreads() const
+	{
+		return this->threads.size();
+	}
+
+	inline const std::deque<SrtpCryptoPool::Batch*>& SrtpCryptoPool::GetPendingBatches() const
+	{
+		return this->pendingBatches;
+	}
+} // namespace RTC
+
+#endif
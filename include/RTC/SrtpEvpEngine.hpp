@@ -0,0 +1,57 @@
+#ifndef MS_RTC_SRTP_EVP_ENGINE_HPP
+#define MS_RTC_SRTP_EVP_ENGINE_HPP
+
+#include "common.hpp"
+#include "RTC/SrtpSession.hpp"
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <unordered_map>
+
+namespace RTC
+{
+	/**
+	 * Native SRTP protection of outgoing RTP packets (RFC 3711 and RFC 7714)
+	 * on top of OpenSSL EVP. Session keys are derived and expanded once so each
+	 * packet just sets the cipher IV, and the HMAC-SHA1 key pads are hashed in
+	 * advance. OpenSSL selects the AES-NI, VAES or AVX-512 implementation at
+	 * runtime based on the CPU capabilities.
+	 */
+	class SrtpEvpEngine
+	{
+	public:
+		SrtpEvpEngine(RTC::SrtpSession::Profile profile, const uint8_t* key, size_t keyLen);
+		~SrtpEvpEngine();
+
+	public:
+		bool EncryptRtp(uint8_t* data, size_t* len);
+		void RemoveStream(uint32_t ssrc);
+
+	private:
+		void DeriveSessionKey(
+		  const EVP_CIPHER* prfCipher,
+		  const uint8_t* masterKey,
+		  const uint8_t* masterSalt,
+		  size_t masterSaltLen,
+		  uint8_t label,
+		  uint8_t* sessionKey,
+		  size_t sessionKeyLen);
+		bool GetPacketIndex(uint32_t ssrc, uint16_t seq, uint64_t& index);
+		bool EncryptRtpAesCm(uint8_t* data, size_t headerLen, size_t* len, uint64_t index);
+		bool EncryptRtpAesGcm(uint8_t* data, size_t headerLen, size_t* len, uint64_t index);
+
+	private:
+		// Allocated by this.
+		EVP_CIPHER_CTX* cipherCtx{ nullptr };
+		// Others.
+		bool aead{ false };
+		size_t tagLen{ 0 };
+		uint8_t sessionSalt[14];
+		// SHA-1 states after hashing the HMAC inner and outer key pads.
+		SHA_CTX authInnerCtx;
+		SHA_CTX authOuterCtx;
+		// Map of SSRC and highest packet index (ROC << 16 | seq) sent.
+		std::unordered_map<uint32_t, uint64_t> mapSsrcPacketIndex;
+	};
+} // namespace RTC
+
+#endif
@@ -3,9 +3,13 @@
 
 #include "common.hpp"
 #include <srtp.h>
+#include <mutex>
+#include <unordered_map>
 
 namespace RTC
 {
+	class SrtpEvpEngine;
+
 	class SrtpSession
 	{
 	public:
@@ -25,8 +29,23 @@ namespace RTC
 			OUTBOUND
 		};
 
+	public:
+		/* Struct for a RTP packet encrypted or decrypted in a batch. */
+		struct RtpBatchItem
+		{
+			// Session to encrypt (OUTBOUND) or decrypt (INBOUND) the packet with
+			// (the item is ignored if null).
+			RTC::SrtpSession* session{ nullptr };
+			// Memory with SRTP_MAX_TRAILER_LEN bytes of space after the packet.
+			uint8_t* data{ nullptr };
+			size_t len{ 0 };
+			Type type{ Type::OUTBOUND };
+			bool processed{ false };
+		};
+
 	public:
 		static void ClassInit();
+		static void ProcessRtpBatch(RtpBatchItem* items, size_t count);
 
 	private:
 		static void OnSrtpEvent(srtp_event_data_t* data);
@@ -37,22 +56,29 @@ namespace RTC
 
 	public:
 		bool EncryptRtp(const uint8_t** data, size_t* len);
+		bool EncryptRtpInPlace(uint8_t* data, size_t* len);
 		bool DecryptSrtp(const uint8_t* data, size_t* len);
 		bool EncryptRtcp(const uint8_t** data, size_t* len);
 		bool DecryptSrtcp(const uint8_t* data, size_t* len);
 		void RemoveStream(uint32_t ssrc);
 
+	private:
+		srtp_t GetSession(uint32_t ssrc) const;
+		srtp_t AddStreamSession(uint32_t ssrc);
+
 	private:
 		// Allocated by this.
 		srtp_t session{ nullptr };
+		// Map of SSRC and libsrtp session holding just the stream of that SSRC.
+		std::unordered_map<uint32_t, srtp_t> mapSsrcSession;
+		// Native engine protecting outgoing RTP (if nativeSrtp setting is enabled).
+		RTC::SrtpEvpEngine* evpEngine{ nullptr };
+		// Others.
+		// Sessions may be used by the loop thread and by a SrtpCryptoPool thread.
+		std::mutex mutex;
+		srtp_policy_t policy;
+		uint8_t key[46];
 	};
-
-	/* Inline instance methods. */
-
-	inline void SrtpSession::RemoveStream(uint32_t ssrc)
-	{
-		srtp_remove_stream(this->session, uint32_t{ htonl(ssrc) });
-	}
 } // namespace RTC
 
 #endif
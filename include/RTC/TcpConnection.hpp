@@ -22,6 +22,7 @@ namespace RTC
 
 	public:
 		void Send(const uint8_t* data, size_t len);
+		void Send(const uint8_t* header, size_t headerLen, const uint8_t* data, size_t len);
 		size_t GetRecvBytes() const;
 		size_t GetSentBytes() const;
 
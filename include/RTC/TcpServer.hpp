@@ -15,12 +15,18 @@ namespace RTC
 		class Listener
 		{
 		public:
+			virtual void OnRtcTcpConnectionAccepted(
+			  RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) = 0;
 			virtual void OnRtcTcpConnectionClosed(
 			  RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) = 0;
 		};
 
 	public:
-		TcpServer(Listener* listener, RTC::TcpConnection::Listener* connListener, std::string& ip);
+		TcpServer(
+		  Listener* listener,
+		  RTC::TcpConnection::Listener* connListener,
+		  std::string& ip,
+		  size_t maxConnections = 10);
 		~TcpServer() override;
 
 		/* Pure virtual methods inherited from ::TcpServer. */
@@ -33,6 +39,7 @@ namespace RTC
 		// Passed by argument.
 		Listener* listener{ nullptr };
 		RTC::TcpConnection::Listener* connListener{ nullptr };
+		size_t maxConnections{ 0 };
 	};
 } // namespace RTC
 
@@ -6,6 +6,7 @@
 #include "Channel/Request.hpp"
 #include "RTC/Consumer.hpp"
 #include "RTC/DataConsumer.hpp"
+#include "RTC/EgressRtpPacket.hpp"
 #include "RTC/DataProducer.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
@@ -131,7 +132,7 @@ namespace RTC
 		RTC::DataConsumer* GetDataConsumerFromRequest(Channel::Request* request) const;
 		virtual bool IsConnected() const = 0;
 		virtual void SendRtpPacket(
-		  RTC::RtpPacket* packet,
+		  const RTC::EgressRtpPacket& egressPacket,
 		  RTC::Consumer* consumer,
 		  bool retransmitted = false,
 		  bool probation     = false) = 0;
@@ -156,7 +157,8 @@ namespace RTC
 
 		/* Pure virtual methods inherited from RTC::Consumer::Listener. */
 	public:
-		void OnConsumerSendRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet) override;
+		void OnConsumerSendRtpPacket(
+		  RTC::Consumer* consumer, const RTC::EgressRtpPacket& egressPacket) override;
 		void OnConsumerRetransmitRtpPacket(
 		  RTC::Consumer* consumer, RTC::RtpPacket* packet, bool probation) override;
 		void OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc) override;
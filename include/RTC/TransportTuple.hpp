@@ -31,11 +31,13 @@ namespace RTC
 		bool Compare(const TransportTuple* tuple) const;
 		void SetLocalAnnouncedIp(std::string& localAnnouncedIp);
 		void Send(const uint8_t* data, size_t len);
+		void Send(const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2);
 		Protocol GetProtocol() const;
 		const struct sockaddr* GetLocalAddress() const;
 		const struct sockaddr* GetRemoteAddress() const;
 		size_t GetRecvBytes() const;
 		size_t GetSentBytes() const;
+		bool IsBacklogged() const;
 
 	private:
 		// Passed by argument.
@@ -113,6 +115,15 @@ namespace RTC
 			this->tcpConnection->Send(data, len);
 	}
 
+	inline void TransportTuple::Send(
+	  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2)
+	{
+		if (this->protocol == Protocol::UDP)
+			this->udpSocket->Send(data1, len1, data2, len2, this->udpRemoteAddr);
+		else
+			this->tcpConnection->Send(data1, len1, data2, len2);
+	}
+
 	inline const struct sockaddr* TransportTuple::GetLocalAddress() const
 	{
 		if (this->protocol == Protocol::UDP)
@@ -144,6 +155,15 @@ namespace RTC
 		else
 			return this->tcpConnection->GetSentBytes();
 	}
+
+	// Whether previously sent data is still waiting for room in the socket.
+	inline bool TransportTuple::IsBacklogged() const
+	{
+		if (this->protocol == Protocol::UDP)
+			return this->udpSocket->GetSendQueuedBytes() != 0;
+		else
+			return this->tcpConnection->GetWriteQueueSize() != 0;
+	}
 } // namespace RTC
 
 #endif
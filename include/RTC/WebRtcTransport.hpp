@@ -2,10 +2,14 @@
 #define MS_RTC_WEBRTC_TRANSPORT_HPP
 
 #include "RTC/DtlsTransport.hpp"
+#include "RTC/EgressPriorityQueue.hpp"
 #include "RTC/IceCandidate.hpp"
 #include "RTC/IceServer.hpp"
 #include "RTC/RembClient.hpp"
 #include "RTC/RembServer/RemoteBitrateEstimatorAbsSendTime.hpp"
+#include "RTC/SharedTcpServer.hpp"
+#include "RTC/SharedUdpSocket.hpp"
+#include "RTC/SrtpCryptoPool.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "RTC/StunPacket.hpp"
 #include "RTC/TcpConnection.hpp"
@@ -24,7 +28,8 @@ namespace RTC
 	                        public RTC::IceServer::Listener,
 	                        public RTC::DtlsTransport::Listener,
 	                        public RTC::RembClient::Listener,
-	                        public RTC::RembServer::RemoteBitrateEstimator::Listener
+	                        public RTC::RembServer::RemoteBitrateEstimator::Listener,
+	                        public RTC::EgressPriorityQueue::Listener
 	{
 	private:
 		struct ListenIp
@@ -33,6 +38,15 @@ namespace RTC
 			std::string announcedIp;
 		};
 
+	public:
+		static void ClassInit();
+		static void ClassDestroy();
+
+	private:
+		static void FlushRtpBatch();
+		static void SubmitRtpBatch(size_t batchIdx);
+		static void OnRtpBatchProcessed(RTC::SrtpCryptoPool::Batch* batch);
+
 	public:
 		WebRtcTransport(const std::string& id, RTC::Transport::Listener* listener, json& data);
 		~WebRtcTransport() override;
@@ -46,10 +60,15 @@ namespace RTC
 		bool IsConnected() const override;
 		void MayRunDtlsTransport();
 		void SendRtpPacket(
-		  RTC::RtpPacket* packet,
+		  const RTC::EgressRtpPacket& egressPacket,
 		  RTC::Consumer* consumer,
 		  bool retransmitted = false,
 		  bool probation     = false) override;
+		void SendEncryptedRtpPacket(
+		  const uint8_t* data, size_t len, RTC::EgressPriorityQueue::Priority priority);
+		uint8_t* AddRtpBatchPacket(
+		  RTC::SrtpSession::Type type, size_t len, RTC::EgressPriorityQueue::Priority priority);
+		void WaitForCryptoPool() const;
 		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
 		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) override;
 		void DistributeAvailableOutgoingBitrate();
@@ -57,6 +76,8 @@ namespace RTC
 		void OnStunDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnDtlsDataReceived(const RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void OnRtpDataDecrypted(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void OnRtpDataDecryptionFailed(const uint8_t* data, size_t len);
 		void OnRtcpDataReceived(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 
 		/* Pure virtual methods inherited from RTC::Transport. */
@@ -77,6 +98,8 @@ namespace RTC
 
 		/* Pure virtual methods inherited from RTC::TcpServer::Listener. */
 	public:
+		void OnRtcTcpConnectionAccepted(
+		  RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) override;
 		void OnRtcTcpConnectionClosed(RTC::TcpServer* tcpServer, RTC::TcpConnection* connection) override;
 
 		/* Pure virtual methods inherited from RTC::TcpConnection::Listener. */
@@ -90,6 +113,7 @@ namespace RTC
 		  const RTC::IceServer* iceServer,
 		  const RTC::StunPacket* packet,
 		  RTC::TransportTuple* tuple) override;
+		void OnIceServerTupleAdded(const RTC::IceServer* iceServer, RTC::TransportTuple* tuple) override;
 		void OnIceServerSelectedTuple(const RTC::IceServer* iceServer, RTC::TransportTuple* tuple) override;
 		void OnIceServerConnected(const RTC::IceServer* iceServer) override;
 		void OnIceServerCompleted(const RTC::IceServer* iceServer) override;
@@ -124,12 +148,22 @@ namespace RTC
 		  const std::vector<uint32_t>& ssrcs,
 		  uint32_t availableBitrate) override;
 
+		/* Pure virtual methods inherited from RTC::EgressPriorityQueue::Listener. */
+	public:
+		bool OnEgressPriorityQueueCanSend(const RTC::EgressPriorityQueue* egressQueue) override;
+		void OnEgressPriorityQueueSend(
+		  const RTC::EgressPriorityQueue* egressQueue, const uint8_t* data, size_t len) override;
+
 	private:
 		// Allocated by this.
 		RTC::IceServer* iceServer{ nullptr };
 		// Map of UdpSocket/TcpServer and local announced IP (if any).
 		std::unordered_map<RTC::UdpSocket*, std::string> udpSockets;
 		std::unordered_map<RTC::TcpServer*, std::string> tcpServers;
+		// Worker wide UDP sockets (if sharedUdpSocket setting is enabled).
+		std::vector<RTC::SharedUdpSocket*> sharedUdpSockets;
+		// Worker wide ICE-TCP listeners (if sharedTcpServer setting is enabled).
+		std::vector<RTC::SharedTcpServer*> sharedTcpServers;
 		RTC::DtlsTransport* dtlsTransport{ nullptr };
 		RTC::SrtpSession* srtpRecvSession{ nullptr };
 		RTC::SrtpSession* srtpSendSession{ nullptr };
@@ -143,6 +177,10 @@ namespace RTC
 		uint32_t initialAvailableOutgoingBitrate{ 600000 };
 		uint32_t minimumAvailableOutgoingBitrate{ 300000 };
 		uint32_t maxIncomingBitrate{ 0 };
+		// Batch (and crypto pool thread) the RTP packets of this transport go to.
+		size_t rtpBatchIdx{ 0 };
+		// RTP packets waiting for the selected tuple to be writable.
+		RTC::EgressPriorityQueue egressQueue{ this };
 	};
 } // namespace RTC
 
@@ -37,6 +37,41 @@ public:
 		uint16_t rtcMaxPort{ 59999 };
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
+		// Max number of UDP datagrams read per recvmmsg() call (0 disables it).
+		uint16_t udpRecvBatchSize{ 32 };
+		// Max number of UDP datagrams sent per sendmmsg() call when flushing the
+		// per socket egress queue once per loop iteration (0 disables it).
+		uint16_t udpSendBatchSize{ 32 };
+		// Whether UDP GRO receive coalescing is enabled (requires udpRecvBatchSize).
+		bool udpGro{ false };
+		// Max bytes a UDP socket may keep queued in libuv when the kernel send
+		// buffer is full (0 means unlimited). Further datagrams are dropped.
+		uint32_t udpSendQueueMaxBytes{ 1048576 };
+		// Max bytes a WebRtcTransport may send in a burst above its pacing
+		// bitrate (0 disables pacing).
+		uint32_t pacerBurstBytes{ 0 };
+		// Whether all the WebRtcTransports share a single UDP socket per listen IP.
+		bool sharedUdpSocket{ false };
+		// Whether all the WebRtcTransports share a single ICE-TCP listener per listen IP.
+		bool sharedTcpServer{ false };
+		// Whether UDP sockets use the io_uring engine (Linux only).
+		bool ioUring{ false };
+		// Whether outgoing SRTP is protected by the native OpenSSL EVP engine
+		// instead of libsrtp.
+		bool nativeSrtp{ false };
+		// Max number of outgoing RTP packets encrypted together once per loop
+		// iteration (0 disables it).
+		uint16_t srtpBatchSize{ 0 };
+		// Number of threads, each one running its own libuv loop, among which
+		// Routers are distributed (0 runs every Router in the main loop).
+		uint16_t workerThreads{ 0 };
+		// Number of threads per libuv loop encrypting and decrypting the SRTP
+		// batches of its WebRtcTransports (0 does it in the loop). Requires
+		// srtpBatchSize.
+		uint16_t srtpCryptoThreads{ 0 };
+		// Number of threads per libuv loop running the DTLS handshakes of its
+		// WebRtcTransports (0 does it in the loop).
+		uint16_t dtlsHandshakeThreads{ 0 };
 	};
 
 public:
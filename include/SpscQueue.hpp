@@ -0,0 +1,111 @@
+#ifndef MS_SPSC_QUEUE_HPP
+#define MS_SPSC_QUEUE_HPP
+
+#include "common.hpp"
+#include <atomic>
+#include <thread>  // std::this_thread::yield()
+#include <utility> // std::move()
+#include <vector>
+
+/**
+ * Bounded lock-free queue with a single producer thread and a single consumer
+ * thread. The capacity is rounded up to a power of two.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+	explicit SpscQueue(size_t capacity);
+	SpscQueue& operator=(const SpscQueue&) = delete;
+	SpscQueue(const SpscQueue&)            = delete;
+
+public:
+	bool Push(T&& item);
+	void PushWait(T&& item);
+	bool Pop(T& item);
+	bool IsEmpty() const;
+
+private:
+	// Others.
+	std::vector<T> items;
+	size_t mask{ 0 };
+	// Written by the consumer and by the producer respectively so keep them in
+	// different cache lines.
+	uint8_t padding[64];
+	std::atomic<size_t> head{ 0 };
+	uint8_t headPadding[64 - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail{ 0 };
+	uint8_t tailPadding[64 - sizeof(std::atomic<size_t>)];
+};
+
+/* Inline instance methods. */
+
+template<typename T>
+inline SpscQueue<T>::SpscQueue(size_t capacity)
+{
+	size_t size{ 1 };
+
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+
+	this->items.resize(size);
+	this->mask = size - 1;
+}
+
+/**
+ * Called by the producer thread. Returns false if the queue is full.
+ */
+template<typename T>
+inline bool SpscQueue<T>::Push(T&& item)
+{
+	auto tail = this->tail.load(std::memory_order_relaxed);
+
+	if (tail - this->head.load(std::memory_order_acquire) > this->mask)
+		return false;
+
+	this->items[tail & this->mask] = std::move(item);
+	this->tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+/**
+ * Called by the producer thread. Yields until there is room, so the consumer
+ * must keep draining the queue.
+ */
+template<typename T>
+inline void SpscQueue<T>::PushWait(T&& item)
+{
+	while (!Push(std::move(item)))
+	{
+		std::this_thread::yield();
+	}
+}
+
+/**
+ * Called by the consumer thread. Returns false if the queue is empty.
+ */
+template<typename T>
+inline bool SpscQueue<T>::Pop(T& item)
+{
+	auto head = this->head.load(std::memory_order_relaxed);
+
+	if (head == this->tail.load(std::memory_order_acquire))
+		return false;
+
+	item = std::move(this->items[head & this->mask]);
+	this->head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+template<typename T>
+inline bool SpscQueue<T>::IsEmpty() const
+{
+	return this->head.load(std::memory_order_acquire) ==
+	       this->tail.load(std::memory_order_acquire);
+}
+
+#endif
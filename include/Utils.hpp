@@ -224,9 +224,9 @@ namespace Utils
 		static const uint8_t* GetHmacShA1(const std::string& key, const uint8_t* data, size_t len);
 
 	private:
-		static uint32_t seed;
-		static HMAC_CTX* hmacSha1Ctx;
-		static uint8_t hmacSha1Buffer[];
+		static thread_local uint32_t seed;
+		static thread_local HMAC_CTX* hmacSha1Ctx;
+		static thread_local uint8_t hmacSha1Buffer[];
 		static const uint32_t crc32Table[256];
 	};
 
@@ -246,7 +246,7 @@ namespace Utils
 
 	inline const std::string Crypto::GetRandomString(size_t len)
 	{
-		static char buffer[64];
+		static thread_local char buffer[64];
 		static const char chars[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
 			                            'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
 			                            'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z' };
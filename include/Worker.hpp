@@ -2,6 +2,8 @@
 #define MS_WORKER_HPP
 
 #include "common.hpp"
+#include "DepLibUV.hpp"
+#include "WorkerThread.hpp"
 #include "json.hpp"
 #include "Channel/Request.hpp"
 #include "Channel/UnixStreamSocket.hpp"
@@ -9,6 +11,7 @@
 #include "handles/SignalsHandler.hpp"
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -21,8 +24,11 @@ public:
 private:
 	void Close();
 	void FillJson(json& jsonObject) const;
+	void FillJsonLoopStats(const DepLibUV::LoopStats* stats, json& jsonArray) const;
 	void SetNewRouterIdFromRequest(Channel::Request* request, std::string& routerId) const;
 	RTC::Router* GetRouterFromRequest(Channel::Request* request) const;
+	WorkerThread* GetWorkerThreadFromRequest(Channel::Request* request) const;
+	WorkerThread* GetWorkerThreadForNewRouter() const;
 
 	/* Methods inherited from Channel::lUnixStreamSocket::Listener. */
 public:
@@ -38,9 +44,11 @@ private:
 	Channel::UnixStreamSocket* channel{ nullptr };
 	// Allocated by this.
 	SignalsHandler* signalsHandler{ nullptr };
+	std::vector<WorkerThread*> workerThreads;
 	// Others.
 	bool closed{ false };
 	std::unordered_map<std::string, RTC::Router*> mapRouters;
+	std::unordered_map<std::string, WorkerThread*> mapRouterIdWorkerThread;
 };
 
 #endif
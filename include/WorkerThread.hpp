@@ -0,0 +1,66 @@
+#ifndef MS_WORKER_THREAD_HPP
+#define MS_WORKER_THREAD_HPP
+
+#include "common.hpp"
+#include "ChannelThread.hpp"
+#include "DepLibUV.hpp"
+#include "SpscQueue.hpp"
+#include "Channel/Request.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include "RTC/Router.hpp"
+#include <uv.h>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Thread running its own libuv loop and owning the Routers the Worker assigns
+ * to it. Requests are given to it, and the messages it generates for the
+ * Channel (responses, notifications and logs) are delivered to the main loop,
+ * through lock-free single producer single consumer queues.
+ */
+class WorkerThread : public ChannelThread
+{
+public:
+	explicit WorkerThread(Channel::UnixStreamSocket* channel);
+	~WorkerThread() override;
+
+public:
+	void Close();
+	void PostRequest(Channel::Request* request);
+	const DepLibUV::LoopStats* GetLoopStats() const;
+
+private:
+	void HandleRequest(Channel::Request* request);
+	RTC::Router* GetRouterFromRequest(Channel::Request* request) const;
+
+	/* Pure virtual methods inherited from ChannelThread. */
+protected:
+	void UserOnThread() override;
+	void NotifyLoop() override;
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvRequests();
+
+private:
+	// Allocated by this.
+	uv_async_t* requestsUvHandle{ nullptr };
+	uv_async_t* messagesUvHandle{ nullptr };
+	// Others.
+	uv_sem_t readySem;
+	// Set by the thread before it is ready.
+	const DepLibUV::LoopStats* loopStats{ nullptr };
+	SpscQueue<Channel::Request*> requests;
+	bool closed{ false };
+	// Just accessed from the thread.
+	std::unordered_map<std::string, RTC::Router*> mapRouters;
+};
+
+/* Inline instance methods. */
+
+inline const DepLibUV::LoopStats* WorkerThread::GetLoopStats() const
+{
+	return this->loopStats;
+}
+
+#endif
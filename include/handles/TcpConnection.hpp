@@ -60,6 +60,7 @@ public:
 	const struct sockaddr* GetPeerAddress() const;
 	const std::string& GetPeerIp() const;
 	uint16_t GetPeerPort() const;
+	size_t GetWriteQueueSize() const;
 
 private:
 	bool SetPeerAddress();
@@ -151,4 +152,9 @@ inline uint16_t TcpConnection::GetPeerPort() const
 	return this->peerPort;
 }
 
+inline size_t TcpConnection::GetWriteQueueSize() const
+{
+	return uv_stream_get_write_queue_size(reinterpret_cast<uv_stream_t*>(this->uvHandle));
+}
+
 #endif
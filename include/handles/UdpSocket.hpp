@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include <uv.h>
 #include <string>
+#include <vector>
 
 class UdpSocket
 {
@@ -12,9 +13,24 @@ public:
 	struct UvSendData
 	{
 		uv_udp_send_t req;
+		size_t len;
 		uint8_t store[1];
 	};
 
+private:
+	/* Struct for a datagram waiting in the egress queue. */
+	struct SendQueueItem
+	{
+		const uint8_t* data;
+		size_t len;
+		struct sockaddr_storage addr;
+	};
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static void FlushAll();
+
 public:
 	/**
 	 * uvHandle must be an already initialized and binded uv_udp_t pointer.
@@ -28,6 +44,12 @@ public:
 	void Close();
 	virtual void Dump() const;
 	void Send(const uint8_t* data, size_t len, const struct sockaddr* addr);
+	void Send(
+	  const uint8_t* data1,
+	  size_t len1,
+	  const uint8_t* data2,
+	  size_t len2,
+	  const struct sockaddr* addr);
 	void Send(const std::string& data, const struct sockaddr* addr);
 	void Send(const uint8_t* data, size_t len, const std::string& ip, uint16_t port);
 	void Send(const std::string& data, const std::string& ip, uint16_t port);
@@ -37,15 +59,49 @@ public:
 	uint16_t GetLocalPort() const;
 	size_t GetRecvBytes() const;
 	size_t GetSentBytes() const;
+	size_t GetSendBatches() const;
+	size_t GetSendBatchedDatagrams() const;
+	size_t GetSendGsoDatagrams() const;
+	size_t GetRecvGroDatagrams() const;
+	size_t GetSendQueuedBytes() const;
+	size_t GetSendDrops() const;
 
 private:
 	bool SetLocalAddress();
+	void RecvBatch();
+	size_t GetGroSegmentSize(const struct msghdr* msg) const;
+	void Enqueue(
+	  const uint8_t* data1,
+	  size_t len1,
+	  const uint8_t* data2,
+	  size_t len2,
+	  const struct sockaddr* addr);
+	void FlushSendQueue();
+	size_t GetGsoRunLength(size_t idx) const;
+	void SendDatagram(
+	  const uint8_t* data1,
+	  size_t len1,
+	  const uint8_t* data2,
+	  size_t len2,
+	  const struct sockaddr* addr);
+	void SendWithUvRequest(
+	  const uint8_t* data1,
+	  size_t len1,
+	  const uint8_t* data2,
+	  size_t len2,
+	  const struct sockaddr* addr);
 
 	/* Callbacks fired by UV events. */
 public:
 	void OnUvRecvAlloc(size_t suggestedSize, uv_buf_t* buf);
 	void OnUvRecv(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags);
-	void OnUvSendError(int error);
+	void OnUvSend(int status, size_t len);
+
+	/* Callbacks fired by io_uring events. */
+public:
+	void OnIoUringRecv(const uint8_t* data, size_t len, const struct sockaddr* addr);
+	void OnIoUringRecvFailed();
+	void OnIoUringSend(int result, const uint8_t* data, size_t len, const struct sockaddr* addr);
 
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
@@ -61,9 +117,26 @@ private:
 	// Allocated by this (may be passed by argument).
 	uv_udp_t* uvHandle{ nullptr };
 	// Others.
+	uv_os_fd_t fd{ -1 };
 	bool closed{ false };
+	// Multishot receive request id when using io_uring (0 otherwise).
+	uint64_t ioUringRecvId{ 0 };
 	size_t recvBytes{ 0 };
 	size_t sentBytes{ 0 };
+	std::vector<SendQueueItem> sendQueue;
+	bool pendingFlush{ false };
+	bool gsoEnabled{ false };
+	bool groEnabled{ false };
+	size_t sendBatches{ 0 };
+	size_t sendBatchedDatagrams{ 0 };
+	size_t sendGsoDatagrams{ 0 };
+	size_t recvGroDatagrams{ 0 };
+	size_t sendQueuedBytes{ 0 };
+	size_t sendDrops{ 0 };
+
+private:
+	// Sockets with datagrams in their egress queue.
+	static thread_local std::vector<UdpSocket*> pendingSockets;
 };
 
 /* Inline methods. */
@@ -108,4 +181,34 @@ inline size_t UdpSocket::GetSentBytes() const
 	return this->sentBytes;
 }
 
+inline size_t UdpSocket::GetSendBatches() const
+{
+	return this->sendBatches;
+}
+
+inline size_t UdpSocket::GetSendBatchedDatagrams() const
+{
+	return this->sendBatchedDatagrams;
+}
+
+inline size_t UdpSocket::GetSendGsoDatagrams() const
+{
+	return this->sendGsoDatagrams;
+}
+
+inline size_t UdpSocket::GetRecvGroDatagrams() const
+{
+	return this->recvGroDatagrams;
+}
+
+inline size_t UdpSocket::GetSendQueuedBytes() const
+{
+	return this->sendQueuedBytes;
+}
+
+inline size_t UdpSocket::GetSendDrops() const
+{
+	return this->sendDrops;
+}
+
 #endif
@@ -0,0 +1,92 @@
+#define MS_CLASS "BufferPool"
+// #define MS_LOG_DEV
+
+#include "BufferPool.hpp"
+#include "Logger.hpp"
+#include <cstddef> // std::max_align_t
+#include <cstdlib> // std::malloc(), std::free()
+
+/* Static. */
+
+static constexpr size_t MinSizeClassBits{ 8 };
+static constexpr size_t NumSizeClasses{ 9 };
+static constexpr size_t MaxPooledBuffersPerClass{ 256 };
+// Room before each buffer for its size class, keeping the malloc() alignment.
+static constexpr size_t HeaderSize{ alignof(std::max_align_t) };
+static constexpr uint8_t UnpooledSizeClass{ 255 };
+
+/* Class variables. */
+
+thread_local std::vector<uint8_t*> BufferPool::pools[NumSizeClasses];
+
+/* Class methods. */
+
+void BufferPool::ClassDestroy()
+{
+	MS_TRACE();
+
+	for (auto& pool : BufferPool::pools)
+	{
+		for (auto* block : pool)
+		{
+			std::free(block);
+		}
+
+		pool.clear();
+	}
+}
+
+uint8_t* BufferPool::Allocate(size_t size)
+{
+	MS_TRACE();
+
+	uint8_t sizeClass{ 0 };
+
+	while (sizeClass < NumSizeClasses && (size_t{ 1 } << (MinSizeClassBits + sizeClass)) < size)
+	{
+		++sizeClass;
+	}
+
+	uint8_t* block;
+
+	if (sizeClass == NumSizeClasses)
+	{
+		block    = static_cast<uint8_t*>(std::malloc(HeaderSize + size));
+		block[0] = UnpooledSizeClass;
+	}
+	else if (!BufferPool::pools[sizeClass].empty())
+	{
+		block = BufferPool::pools[sizeClass].back();
+		BufferPool::pools[sizeClass].pop_back();
+	}
+	else
+	{
+		block = static_cast<uint8_t*>(
+		  std::malloc(HeaderSize + (size_t{ 1 } << (MinSizeClassBits + sizeClass))));
+		block[0] = sizeClass;
+	}
+
+	return block + HeaderSize;
+}
+
+void BufferPool::Free(uint8_t* buffer)
+{
+	MS_TRACE();
+
+	uint8_t* block    = buffer - HeaderSize;
+	uint8_t sizeClass = block[0];
+
+	// clang-format off
+	if (
+		sizeClass == UnpooledSizeClass ||
+		BufferPool::pools[sizeClass].size() >= MaxPooledBuffersPerClass
+	)
+	// clang-format on
+	{
+		std::free(block);
+
+		return;
+	}
+
+	BufferPool::pools[sizeClass].push_back(block);
+}
@@ -20,6 +20,21 @@ namespace Channel
 	static constexpr size_t NsPayloadMaxLen{ 4194304 };
 	static uint8_t WriteBuffer[NsMessageMaxLen];
 
+	/* Class variables. */
+
+	thread_local UnixStreamSocket::Forwarder* UnixStreamSocket::threadForwarder{ nullptr };
+
+	/* Class methods. */
+
+	/**
+	 * Called by a thread not running the Channel so the messages it generates
+	 * (responses, notifications and logs) are given to the forwarder.
+	 */
+	void UnixStreamSocket::SetThreadForwarder(Forwarder* forwarder)
+	{
+		UnixStreamSocket::threadForwarder = forwarder;
+	}
+
 	/* Instance methods. */
 
 	UnixStreamSocket::UnixStreamSocket(int fd)
@@ -37,11 +52,19 @@ namespace Channel
 
 	void UnixStreamSocket::Send(json& jsonMessage)
 	{
+		std::string nsPayload = jsonMessage.dump();
+		size_t nsPayloadLen   = nsPayload.length();
+
+		if (UnixStreamSocket::threadForwarder)
+		{
+			UnixStreamSocket::threadForwarder->ForwardChannelMessage(nsPayload.c_str(), nsPayloadLen);
+
+			return;
+		}
+
 		if (IsClosed())
 			return;
 
-		std::string nsPayload = jsonMessage.dump();
-		size_t nsPayloadLen   = nsPayload.length();
 		size_t nsNumLen;
 		size_t nsLen;
 
@@ -74,6 +97,13 @@ namespace Channel
 
 	void UnixStreamSocket::SendLog(char* nsPayload, size_t nsPayloadLen)
 	{
+		if (UnixStreamSocket::threadForwarder)
+		{
+			UnixStreamSocket::threadForwarder->ForwardChannelMessage(nsPayload, nsPayloadLen);
+
+			return;
+		}
+
 		if (IsClosed())
 			return;
 
@@ -111,6 +141,14 @@ namespace Channel
 
 	void UnixStreamSocket::SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen)
 	{
+		if (UnixStreamSocket::threadForwarder)
+		{
+			UnixStreamSocket::threadForwarder->ForwardChannelMessage(
+			  reinterpret_cast<const char*>(nsPayload), nsPayloadLen);
+
+			return;
+		}
+
 		if (IsClosed())
 			return;
 
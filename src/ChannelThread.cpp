@@ -0,0 +1,103 @@
+#define MS_CLASS "ChannelThread"
+// #define MS_LOG_DEV
+
+#include "ChannelThread.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include <thread> // std::this_thread::yield()
+
+/* Static. */
+
+// Like the default stack of the main thread. The static TLS (a few hundred KB)
+// is taken from it too.
+static constexpr size_t ThreadStackSize{ 8 * 1024 * 1024 };
+
+/* Static methods for UV callbacks. */
+
+inline static void onThread(void* arg)
+{
+	static_cast<ChannelThread*>(arg)->OnUvThread();
+}
+
+/* Instance methods. */
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+ChannelThread::ChannelThread(
+  Channel::UnixStreamSocket* channel, size_t messagesQueueSize, QueueFullPolicy queueFullPolicy)
+  : channel(channel), queueFullPolicy(queueFullPolicy), messages(messagesQueueSize)
+{
+	MS_TRACE();
+}
+
+ChannelThread::~ChannelThread()
+{
+	MS_TRACE();
+}
+
+/**
+ * Called from the loop thread.
+ */
+void ChannelThread::DeliverMessages()
+{
+	MS_TRACE();
+
+	std::string message;
+
+	while (this->messages.Pop(message))
+	{
+		this->channel->SendBinary(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+	}
+}
+
+/**
+ * Must be called once the subclass is ready for UserOnThread().
+ */
+void ChannelThread::Start()
+{
+	MS_TRACE();
+
+	uv_thread_options_t options;
+
+	options.flags      = UV_THREAD_HAS_STACK_SIZE;
+	options.stack_size = ThreadStackSize;
+
+	int err =
+	  uv_thread_create_ex(&this->uvThread, &options, static_cast<uv_thread_cb>(onThread), this);
+
+	if (err != 0)
+		MS_THROW_ERROR("uv_thread_create_ex() failed: %s", uv_strerror(err));
+}
+
+void ChannelThread::Join()
+{
+	MS_TRACE();
+
+	uv_thread_join(&this->uvThread);
+}
+
+/**
+ * Called from the thread.
+ */
+void ChannelThread::ForwardChannelMessage(const char* nsPayload, size_t nsPayloadLen)
+{
+	std::string message(nsPayload, nsPayloadLen);
+
+	while (!this->messages.Push(std::move(message)))
+	{
+		// The loop may not drain the queue anymore (or not until we are done).
+		if (this->queueFullPolicy == QueueFullPolicy::DROP || this->stopping.load())
+			return;
+
+		std::this_thread::yield();
+	}
+
+	NotifyLoop();
+}
+
+void ChannelThread::OnUvThread()
+{
+	// Messages for the Channel generated in this thread are given to us.
+	Channel::UnixStreamSocket::SetThreadForwarder(this);
+
+	UserOnThread();
+}
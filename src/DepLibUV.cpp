@@ -3,11 +3,40 @@
 
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include <poll.h>
+#include <cerrno>
 #include <cstdlib> // std::abort()
 
+/* Static. */
+
+// Iterations whose callbacks take longer than this delay the processing of
+// every other handle of the loop.
+static constexpr uint64_t StallThresholdNs{ 20 * 1000 * 1000 };
+
 /* Static variables. */
 
-uv_loop_t* DepLibUV::loop{ nullptr };
+thread_local uv_loop_t* DepLibUV::loop{ nullptr };
+thread_local uv_prepare_t* DepLibUV::prepareHandle{ nullptr };
+thread_local uv_check_t* DepLibUV::checkHandle{ nullptr };
+thread_local std::vector<DepLibUV::FlushCallback> DepLibUV::flushCallbacks;
+thread_local DepLibUV::LoopStats DepLibUV::loopStats;
+
+/* Static methods for UV callbacks. */
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	DepLibUV::OnUvLoopIteration();
+}
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	DepLibUV::OnUvLoopIteration();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
 
 /* Static methods. */
 
@@ -21,6 +50,27 @@ void DepLibUV::ClassInit()
 
 	if (err != 0)
 		MS_ABORT("libuv initialization failed");
+
+	// Prepare handle runs before blocking for I/O (so data generated by timers
+	// is flushed) and check handle runs right after processing I/O. None of them
+	// must keep the loop alive.
+	DepLibUV::prepareHandle = new uv_prepare_t;
+	DepLibUV::checkHandle   = new uv_check_t;
+
+	err = uv_prepare_init(DepLibUV::loop, DepLibUV::prepareHandle);
+
+	if (err != 0)
+		MS_ABORT("uv_prepare_init() failed");
+
+	err = uv_check_init(DepLibUV::loop, DepLibUV::checkHandle);
+
+	if (err != 0)
+		MS_ABORT("uv_check_init() failed");
+
+	uv_prepare_start(DepLibUV::prepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+	uv_check_start(DepLibUV::checkHandle, static_cast<uv_check_cb>(onCheck));
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUV::prepareHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUV::checkHandle));
 }
 
 void DepLibUV::ClassDestroy()
@@ -30,8 +80,19 @@ void DepLibUV::ClassDestroy()
 	// This should never happen.
 	if (DepLibUV::loop != nullptr)
 	{
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(DepLibUV::prepareHandle), static_cast<uv_close_cb>(onClose));
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(DepLibUV::checkHandle), static_cast<uv_close_cb>(onClose));
+
+		// Run the loop once more so close callbacks are called.
+		uv_run(DepLibUV::loop, UV_RUN_NOWAIT);
+
 		uv_loop_close(DepLibUV::loop);
 		delete DepLibUV::loop;
+
+		DepLibUV::loop = nullptr;
+		DepLibUV::flushCallbacks.clear();
 	}
 }
 
@@ -49,5 +110,76 @@ void DepLibUV::RunLoop()
 	// This should never happen.
 	MS_ASSERT(DepLibUV::loop != nullptr, "loop unset");
 
-	uv_run(DepLibUV::loop, UV_RUN_DEFAULT);
+	// Same as UV_RUN_DEFAULT, but waiting for events out of uv_run() so the
+	// time spent in callbacks can be measured.
+	while (true)
+	{
+		uint64_t startNs = uv_hrtime();
+		int alive        = uv_run(DepLibUV::loop, UV_RUN_NOWAIT);
+
+		RecordIteration(uv_hrtime() - startNs);
+
+		if (alive == 0)
+			break;
+
+		WaitForEvents();
+	}
+}
+
+void DepLibUV::AddFlushCallback(FlushCallback callback)
+{
+	MS_TRACE();
+
+	DepLibUV::flushCallbacks.push_back(callback);
+}
+
+/**
+ * Blocks until the loop has events to process or its next timer is due.
+ */
+void DepLibUV::WaitForEvents()
+{
+	MS_TRACE();
+
+	struct pollfd pfd;
+
+	pfd.fd      = uv_backend_fd(DepLibUV::loop);
+	pfd.events  = POLLIN;
+	pfd.revents = 0;
+
+	int timeout = uv_backend_timeout(DepLibUV::loop);
+
+	if (timeout == 0)
+		return;
+
+	int ret;
+
+	do
+	{
+		ret = poll(&pfd, 1, timeout);
+	} while (ret == -1 && errno == EINTR);
+}
+
+void DepLibUV::RecordIteration(uint64_t iterationTimeNs)
+{
+	auto& stats = DepLibUV::loopStats;
+
+	stats.iterations.fetch_add(1, std::memory_order_relaxed);
+	stats.busyTimeNs.fetch_add(iterationTimeNs, std::memory_order_relaxed);
+
+	if (iterationTimeNs > stats.maxIterationTimeNs.load(std::memory_order_relaxed))
+		stats.maxIterationTimeNs.store(iterationTimeNs, std::memory_order_relaxed);
+
+	if (iterationTimeNs >= StallThresholdNs)
+	{
+		stats.stalls.fetch_add(1, std::memory_order_relaxed);
+		stats.stallTimeNs.fetch_add(iterationTimeNs, std::memory_order_relaxed);
+	}
+}
+
+void DepLibUV::OnUvLoopIteration()
+{
+	for (auto callback : DepLibUV::flushCallbacks)
+	{
+		callback();
+	}
 }
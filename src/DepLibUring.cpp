@@ -0,0 +1,813 @@
+#define MS_CLASS "DepLibUring"
+// #define MS_LOG_DEV
+
+#include "DepLibUring.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "Settings.hpp"
+#include "handles/UdpSocket.hpp"
+#include <cerrno>
+#include <cstring> // std::memset(), std::memcpy(), std::strerror()
+#ifdef __linux__
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Provided buffer rings and multishot recvmsg need Linux >= 6.0 UAPI headers.
+// Otherwise io_uring is reported as not available and libuv is used.
+#if defined(__linux__) && defined(IORING_RECV_MULTISHOT)
+#define MS_IO_URING_SUPPORTED
+#endif
+
+/* Static. */
+
+static constexpr unsigned int SqEntries{ 1024 };
+static constexpr unsigned int CqEntries{ 8192 };
+// Provided buffer ring for multishot recvmsg. Each buffer holds the
+// io_uring_recvmsg_out header, the source address and the payload.
+static constexpr uint16_t RecvBufferGroup{ 0 };
+static constexpr unsigned int RecvBufferCount{ 1024 };
+static constexpr size_t RecvBufferSize{ 4096 };
+static constexpr unsigned int SendSlotCount{ 1024 };
+// Low bits of the user_data of every submission.
+static constexpr uint64_t UserDataRecv{ 0 };
+static constexpr uint64_t UserDataSend{ 1 };
+static constexpr uint64_t UserDataCancel{ 2 };
+static constexpr uint64_t UserDataTypeMask{ 3 };
+
+#ifdef MS_IO_URING_SUPPORTED
+// Mapped ring (one per thread running a loop).
+static thread_local uint8_t* RingMem{ nullptr };
+static thread_local size_t RingMemSize{ 0 };
+static thread_local struct io_uring_sqe* Sqes{ nullptr };
+static thread_local size_t SqesSize{ 0 };
+static thread_local unsigned int* SqHead{ nullptr };
+static thread_local unsigned int* SqTail{ nullptr };
+static thread_local unsigned int SqMask{ 0 };
+static thread_local unsigned int* SqArray{ nullptr };
+static thread_local unsigned int SqSize{ 0 };
+static thread_local unsigned int* CqHead{ nullptr };
+static thread_local unsigned int* CqTail{ nullptr };
+static thread_local unsigned int CqMask{ 0 };
+static thread_local struct io_uring_cqe* Cqes{ nullptr };
+// Provided buffer ring. Its tail overlaps the reserved field of the first entry.
+static thread_local struct io_uring_buf* RecvBufferRing{ nullptr };
+static thread_local size_t RecvBufferRingSize{ 0 };
+static thread_local uint16_t RecvBufferRingTail{ 0 };
+static thread_local uint8_t* RecvBuffers{ nullptr };
+// Every multishot recvmsg uses the same header, only the lengths are read.
+static thread_local struct msghdr RecvMsg;
+#endif
+
+/* Static methods for UV callbacks. */
+
+inline static void onPoll(uv_poll_t* /*handle*/, int /*status*/, int /*events*/)
+{
+	DepLibUring::OnUvEventFdReadable();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+inline static void onLoopIteration()
+{
+	DepLibUring::OnUvLoopIteration();
+}
+
+/* Static variables. */
+
+thread_local bool DepLibUring::active{ false };
+thread_local bool DepLibUring::recvSupported{ false };
+thread_local int DepLibUring::ringFd{ -1 };
+thread_local int DepLibUring::eventFd{ -1 };
+thread_local uv_poll_t* DepLibUring::uvPollHandle{ nullptr };
+thread_local uint64_t DepLibUring::nextRecvId{ 1 };
+thread_local std::unordered_map<uint64_t, std::pair<UdpSocket*, int>> DepLibUring::mapRecvIdSocket;
+thread_local DepLibUring::SendSlot* DepLibUring::sendSlots{ nullptr };
+thread_local std::vector<uint32_t> DepLibUring::freeSendSlots;
+thread_local unsigned int DepLibUring::pendingSubmissions{ 0 };
+
+/* Static methods. */
+
+void DepLibUring::ClassInit()
+{
+	MS_TRACE();
+
+	if (!Settings::configuration.ioUring)
+		return;
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (!DepLibUring::Setup())
+	{
+		MS_WARN_TAG(info, "io_uring not available, using libuv for UDP I/O");
+
+		DepLibUring::ClassDestroy();
+
+		return;
+	}
+
+	DepLibUring::sendSlots = new SendSlot[SendSlotCount];
+	DepLibUring::freeSendSlots.reserve(SendSlotCount);
+
+	for (uint32_t i{ SendSlotCount }; i > 0; --i)
+	{
+		DepLibUring::freeSendSlots.push_back(i - 1);
+	}
+
+	DepLibUring::uvPollHandle = new uv_poll_t;
+
+	int err = uv_poll_init(DepLibUV::GetLoop(), DepLibUring::uvPollHandle, DepLibUring::eventFd);
+
+	if (err != 0)
+	{
+		delete DepLibUring::uvPollHandle;
+		DepLibUring::uvPollHandle = nullptr;
+
+		MS_WARN_TAG(info, "uv_poll_init() failed, using libuv for UDP I/O: %s", uv_strerror(err));
+
+		DepLibUring::ClassDestroy();
+
+		return;
+	}
+
+	uv_poll_start(DepLibUring::uvPollHandle, UV_READABLE, static_cast<uv_poll_cb>(onPoll));
+	// Like the rest of loop iteration handles, this must not keep the loop alive.
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUring::uvPollHandle));
+
+	DepLibUV::AddFlushCallback(onLoopIteration);
+
+	DepLibUring::active = true;
+
+	MS_DEBUG_TAG(info, "io_uring enabled for UDP I/O");
+#else
+	MS_WARN_TAG(info, "io_uring not supported by this build, using libuv for UDP I/O");
+#endif
+}
+
+void DepLibUring::ClassDestroy()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	DepLibUring::active = false;
+
+	if (DepLibUring::uvPollHandle != nullptr)
+	{
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(DepLibUring::uvPollHandle), static_cast<uv_close_cb>(onClose));
+		DepLibUring::uvPollHandle = nullptr;
+	}
+
+	// Closing the ring cancels every pending request.
+	if (DepLibUring::ringFd != -1)
+	{
+		close(DepLibUring::ringFd);
+		DepLibUring::ringFd = -1;
+	}
+
+	if (DepLibUring::eventFd != -1)
+	{
+		close(DepLibUring::eventFd);
+		DepLibUring::eventFd = -1;
+	}
+
+	if (Sqes != nullptr)
+		munmap(Sqes, SqesSize);
+	if (RingMem != nullptr)
+		munmap(RingMem, RingMemSize);
+	if (RecvBufferRing != nullptr)
+		munmap(RecvBufferRing, RecvBufferRingSize);
+
+	Sqes           = nullptr;
+	RingMem        = nullptr;
+	RecvBufferRing = nullptr;
+
+	delete[] RecvBuffers;
+	RecvBuffers = nullptr;
+
+	delete[] DepLibUring::sendSlots;
+	DepLibUring::sendSlots = nullptr;
+	DepLibUring::freeSendSlots.clear();
+	DepLibUring::mapRecvIdSocket.clear();
+	DepLibUring::pendingSubmissions = 0;
+#endif
+}
+
+uint64_t DepLibUring::StartRecv(UdpSocket* socket, int fd)
+{
+	MS_TRACE();
+
+	if (!DepLibUring::recvSupported)
+		return 0;
+
+	uint64_t recvId = DepLibUring::nextRecvId++;
+
+	if (!DepLibUring::PrepareRecv(fd, recvId))
+		return 0;
+
+	DepLibUring::mapRecvIdSocket[recvId] = std::make_pair(socket, fd);
+
+	DepLibUring::Submit();
+
+	return recvId;
+}
+
+void DepLibUring::StopRecv(uint64_t recvId)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	DepLibUring::mapRecvIdSocket.erase(recvId);
+
+	// Cancel the multishot recvmsg right now, the socket is about to be closed.
+	struct io_uring_sqe* sqe = DepLibUring::GetSqe();
+
+	if (sqe == nullptr)
+	{
+		MS_ERROR("no room in the submission queue to cancel the receive request");
+
+		return;
+	}
+
+	sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+	sqe->fd        = -1;
+	sqe->addr      = (recvId << 2) | UserDataRecv;
+	sqe->user_data = UserDataCancel;
+
+	// NOTE: The caller must call Submit() before closing the fd.
+#endif
+}
+
+bool DepLibUring::PrepareSend(
+  UdpSocket* socket,
+  int fd,
+  const uint8_t* data1,
+  size_t len1,
+  const uint8_t* data2,
+  size_t len2,
+  const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	size_t len = len1 + len2;
+
+	if (len > sizeof(SendSlot::store) || DepLibUring::freeSendSlots.empty())
+		return false;
+
+	struct io_uring_sqe* sqe = DepLibUring::GetSqe();
+
+	if (sqe == nullptr)
+		return false;
+
+	uint32_t slotIdx = DepLibUring::freeSendSlots.back();
+	auto& slot       = DepLibUring::sendSlots[slotIdx];
+
+	DepLibUring::freeSendSlots.pop_back();
+
+	std::memcpy(slot.store, data1, len1);
+
+	if (len2 != 0)
+		std::memcpy(slot.store + len1, data2, len2);
+
+	switch (addr->sa_family)
+	{
+		case AF_INET6:
+			std::memcpy(&slot.addr, addr, sizeof(struct sockaddr_in6));
+			slot.msg.msg_namelen = sizeof(struct sockaddr_in6);
+			break;
+
+		default:
+			std::memcpy(&slot.addr, addr, sizeof(struct sockaddr_in));
+			slot.msg.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	slot.socket             = socket;
+	slot.iov.iov_base       = slot.store;
+	slot.iov.iov_len        = len;
+	slot.msg.msg_name       = &slot.addr;
+	slot.msg.msg_iov        = &slot.iov;
+	slot.msg.msg_iovlen     = 1;
+	slot.msg.msg_control    = nullptr;
+	slot.msg.msg_controllen = 0;
+	slot.msg.msg_flags      = 0;
+
+	sqe->opcode    = IORING_OP_SENDMSG;
+	sqe->fd        = fd;
+	sqe->addr      = reinterpret_cast<uint64_t>(&slot.msg);
+	sqe->len       = 1;
+	sqe->user_data = (static_cast<uint64_t>(slotIdx) << 2) | UserDataSend;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DepLibUring::ForgetSends(UdpSocket* socket)
+{
+	MS_TRACE();
+
+	if (DepLibUring::sendSlots == nullptr)
+		return;
+
+	for (uint32_t slotIdx{ 0 }; slotIdx < SendSlotCount; ++slotIdx)
+	{
+		auto& slot = DepLibUring::sendSlots[slotIdx];
+
+		if (slot.socket == socket)
+			slot.socket = nullptr;
+	}
+}
+
+void DepLibUring::Submit()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	if (DepLibUring::pendingSubmissions == 0)
+		return;
+
+	int ret = static_cast<int>(
+	  syscall(__NR_io_uring_enter, DepLibUring::ringFd, DepLibUring::pendingSubmissions, 0, 0, nullptr, 0));
+
+	// The completion queue is full, make room and retry.
+	if (ret < 0 && (errno == EBUSY || errno == EAGAIN))
+	{
+		DepLibUring::ReapCompletions();
+
+		ret = static_cast<int>(syscall(
+		  __NR_io_uring_enter, DepLibUring::ringFd, DepLibUring::pendingSubmissions, 0, 0, nullptr, 0));
+	}
+
+	if (ret < 0)
+	{
+		MS_ERROR("io_uring_enter() failed: %s", std::strerror(errno));
+
+		return;
+	}
+
+	DepLibUring::pendingSubmissions -= std::min(static_cast<unsigned int>(ret), DepLibUring::pendingSubmissions);
+#endif
+}
+
+bool DepLibUring::Setup()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	struct io_uring_params params; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	std::memset(&params, 0, sizeof(params));
+
+	params.flags      = IORING_SETUP_CQSIZE;
+	params.cq_entries = CqEntries;
+
+	DepLibUring::ringFd = static_cast<int>(syscall(__NR_io_uring_setup, SqEntries, &params));
+
+	if (DepLibUring::ringFd < 0)
+	{
+		MS_WARN_TAG(info, "io_uring_setup() failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+	{
+		MS_WARN_TAG(info, "io_uring without IORING_FEAT_SINGLE_MMAP is not supported");
+
+		return false;
+	}
+
+	// Map the submission and completion rings.
+	size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+	RingMemSize = std::max(sqRingSize, cqRingSize);
+
+	void* mem = mmap(
+	  nullptr,
+	  RingMemSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE,
+	  DepLibUring::ringFd,
+	  IORING_OFF_SQ_RING);
+
+	if (mem == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring rings failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	RingMem = static_cast<uint8_t*>(mem);
+	SqHead  = reinterpret_cast<unsigned int*>(RingMem + params.sq_off.head);
+	SqTail  = reinterpret_cast<unsigned int*>(RingMem + params.sq_off.tail);
+	SqMask  = *reinterpret_cast<unsigned int*>(RingMem + params.sq_off.ring_mask);
+	SqArray = reinterpret_cast<unsigned int*>(RingMem + params.sq_off.array);
+	SqSize  = params.sq_entries;
+	CqHead  = reinterpret_cast<unsigned int*>(RingMem + params.cq_off.head);
+	CqTail  = reinterpret_cast<unsigned int*>(RingMem + params.cq_off.tail);
+	CqMask  = *reinterpret_cast<unsigned int*>(RingMem + params.cq_off.ring_mask);
+	Cqes    = reinterpret_cast<struct io_uring_cqe*>(RingMem + params.cq_off.cqes);
+
+	SqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	mem = mmap(
+	  nullptr,
+	  SqesSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE,
+	  DepLibUring::ringFd,
+	  IORING_OFF_SQES);
+
+	if (mem == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring SQEs failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	Sqes = static_cast<struct io_uring_sqe*>(mem);
+
+	// Completions are signaled through an eventfd so the libuv loop wakes up.
+	DepLibUring::eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (DepLibUring::eventFd < 0)
+	{
+		MS_WARN_TAG(info, "eventfd() failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	if (
+	  syscall(
+	    __NR_io_uring_register, DepLibUring::ringFd, IORING_REGISTER_EVENTFD, &DepLibUring::eventFd, 1) <
+	  0)
+	{
+		MS_WARN_TAG(info, "IORING_REGISTER_EVENTFD failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	// Register the provided buffer ring (it must be page aligned).
+	RecvBufferRingSize = RecvBufferCount * sizeof(struct io_uring_buf);
+
+	mem = mmap(
+	  nullptr, RecvBufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (mem == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring buffer ring failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	RecvBufferRing = static_cast<struct io_uring_buf*>(mem);
+
+	struct io_uring_buf_reg bufReg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	std::memset(&bufReg, 0, sizeof(bufReg));
+
+	bufReg.ring_addr    = reinterpret_cast<uint64_t>(RecvBufferRing);
+	bufReg.ring_entries = RecvBufferCount;
+	bufReg.bgid         = RecvBufferGroup;
+
+	if (
+	  syscall(__NR_io_uring_register, DepLibUring::ringFd, IORING_REGISTER_PBUF_RING, &bufReg, 1) < 0)
+	{
+		MS_WARN_TAG(info, "IORING_REGISTER_PBUF_RING failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	RecvBuffers = new uint8_t[RecvBufferCount * RecvBufferSize];
+
+	for (uint16_t bufferId{ 0 }; bufferId < RecvBufferCount; ++bufferId)
+	{
+		DepLibUring::RecycleBuffer(bufferId);
+	}
+
+	std::memset(&RecvMsg, 0, sizeof(RecvMsg));
+
+	RecvMsg.msg_namelen = sizeof(struct sockaddr_storage);
+
+	DepLibUring::recvSupported = DepLibUring::ProbeRecvMultishot();
+
+	if (!DepLibUring::recvSupported)
+		MS_WARN_TAG(info, "io_uring multishot recvmsg not supported, using libuv for UDP receive");
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool DepLibUring::ProbeRecvMultishot()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if (fd < 0)
+		return false;
+
+	// Kernels without multishot recvmsg reject the request as soon as it is
+	// submitted. Otherwise it stays armed (nobody sends to this socket) until
+	// it is cancelled.
+	// NOTE: Receive id 0 is never given to a UdpSocket.
+	bool supported{ false };
+
+	if (DepLibUring::PrepareRecv(fd, 0))
+	{
+		DepLibUring::Submit();
+
+		supported = DepLibUring::pendingSubmissions == 0;
+
+		unsigned int head = *CqHead;
+
+		while (head != __atomic_load_n(CqTail, __ATOMIC_ACQUIRE))
+		{
+			const auto& cqe = Cqes[head & CqMask];
+
+			if (cqe.user_data == UserDataRecv && cqe.res < 0)
+				supported = false;
+
+			++head;
+		}
+
+		__atomic_store_n(CqHead, head, __ATOMIC_RELEASE);
+	}
+
+	if (supported)
+	{
+		struct io_uring_sqe* sqe = DepLibUring::GetSqe();
+
+		if (sqe != nullptr)
+		{
+			sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+			sqe->fd        = -1;
+			sqe->addr      = UserDataRecv;
+			sqe->user_data = UserDataCancel;
+
+			DepLibUring::Submit();
+		}
+	}
+
+	close(fd);
+
+	return supported;
+#else
+	return false;
+#endif
+}
+
+struct io_uring_sqe* DepLibUring::GetSqe()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	unsigned int tail = *SqTail;
+
+	// Submission queue full, submit what we have so far.
+	if (tail - __atomic_load_n(SqHead, __ATOMIC_ACQUIRE) >= SqSize)
+	{
+		DepLibUring::Submit();
+
+		if (tail - __atomic_load_n(SqHead, __ATOMIC_ACQUIRE) >= SqSize)
+			return nullptr;
+	}
+
+	unsigned int idx = tail & SqMask;
+	auto* sqe        = &Sqes[idx];
+
+	std::memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+	SqArray[idx] = idx;
+
+	// NOTE: The caller fills the SQE before the kernel reads it in the next
+	// io_uring_enter() call.
+	__atomic_store_n(SqTail, tail + 1, __ATOMIC_RELEASE);
+
+	++DepLibUring::pendingSubmissions;
+
+	return sqe;
+#else
+	return nullptr;
+#endif
+}
+
+bool DepLibUring::PrepareRecv(int fd, uint64_t recvId)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	struct io_uring_sqe* sqe = DepLibUring::GetSqe();
+
+	if (sqe == nullptr)
+		return false;
+
+	sqe->opcode    = IORING_OP_RECVMSG;
+	sqe->fd        = fd;
+	sqe->addr      = reinterpret_cast<uint64_t>(&RecvMsg);
+	sqe->len       = 1;
+	sqe->flags     = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = RecvBufferGroup;
+	sqe->ioprio    = IORING_RECV_MULTISHOT;
+	sqe->user_data = (recvId << 2) | UserDataRecv;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DepLibUring::ReapCompletions()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	unsigned int head = *CqHead;
+
+	while (head != __atomic_load_n(CqTail, __ATOMIC_ACQUIRE))
+	{
+		// Copy it and release the entry before notifying anybody.
+		struct io_uring_cqe cqe = Cqes[head & CqMask];
+
+		__atomic_store_n(CqHead, ++head, __ATOMIC_RELEASE);
+
+		switch (cqe.user_data & UserDataTypeMask)
+		{
+			case UserDataRecv:
+			{
+				DepLibUring::OnRecvCompletion(&cqe);
+
+				break;
+			}
+
+			case UserDataSend:
+			{
+				DepLibUring::OnSendCompletion(&cqe);
+
+				break;
+			}
+
+			default:;
+		}
+
+		// The handler may have reaped further completions.
+		head = *CqHead;
+	}
+#endif
+}
+
+void DepLibUring::OnRecvCompletion(const struct io_uring_cqe* cqe)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	uint64_t recvId = cqe->user_data >> 2;
+
+	if ((cqe->flags & IORING_CQE_F_BUFFER) != 0)
+	{
+		auto bufferId = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+		auto* buffer  = RecvBuffers + (bufferId * RecvBufferSize);
+		auto* out     = reinterpret_cast<struct io_uring_recvmsg_out*>(buffer);
+		auto it       = DepLibUring::mapRecvIdSocket.find(recvId);
+
+		if (cqe->res > 0 && it != DepLibUring::mapRecvIdSocket.end())
+		{
+			if ((out->flags & MSG_TRUNC) != 0)
+			{
+				MS_ERROR("received datagram was truncated due to insufficient buffer, ignoring it");
+			}
+			else
+			{
+				auto* addr = reinterpret_cast<struct sockaddr*>(buffer + sizeof(struct io_uring_recvmsg_out));
+				auto* data = buffer + sizeof(struct io_uring_recvmsg_out) + RecvMsg.msg_namelen;
+
+				it->second.first->OnIoUringRecv(data, out->payloadlen, addr);
+			}
+		}
+
+		DepLibUring::RecycleBuffer(bufferId);
+	}
+	// The kernel (or the socket) does not support multishot recvmsg, arming it
+	// again would fail right away so let libuv read the socket instead.
+	else if (cqe->res == -EINVAL || cqe->res == -EOPNOTSUPP)
+	{
+		DepLibUring::recvSupported = false;
+
+		auto it = DepLibUring::mapRecvIdSocket.find(recvId);
+
+		if (it != DepLibUring::mapRecvIdSocket.end())
+		{
+			auto* socket = it->second.first;
+
+			DepLibUring::mapRecvIdSocket.erase(it);
+
+			MS_WARN_TAG(
+			  info,
+			  "io_uring recvmsg failed, using libuv for UDP receive: %s",
+			  std::strerror(-cqe->res));
+
+			socket->OnIoUringRecvFailed();
+		}
+
+		return;
+	}
+	else if (cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED)
+	{
+		MS_DEBUG_DEV("io_uring recvmsg failed: %s", std::strerror(-cqe->res));
+	}
+
+	// The multishot request ended (no more buffers, error...), arm it again if
+	// the socket is still alive.
+	if ((cqe->flags & IORING_CQE_F_MORE) == 0)
+	{
+		auto it = DepLibUring::mapRecvIdSocket.find(recvId);
+
+		if (it != DepLibUring::mapRecvIdSocket.end() && !DepLibUring::PrepareRecv(it->second.second, recvId))
+			MS_ERROR("failed to arm again the io_uring receive request");
+	}
+#endif
+}
+
+void DepLibUring::OnSendCompletion(const struct io_uring_cqe* cqe)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	auto slotIdx = static_cast<uint32_t>(cqe->user_data >> 2);
+	auto& slot   = DepLibUring::sendSlots[slotIdx];
+	auto* socket = slot.socket;
+
+	slot.socket = nullptr;
+
+	if (socket != nullptr)
+	{
+		socket->OnIoUringSend(
+		  cqe->res,
+		  slot.store,
+		  slot.iov.iov_len,
+		  reinterpret_cast<const struct sockaddr*>(&slot.addr));
+	}
+
+	// The slot data is not needed anymore.
+	DepLibUring::freeSendSlots.push_back(slotIdx);
+#endif
+}
+
+void DepLibUring::RecycleBuffer(uint16_t bufferId)
+{
+#ifdef MS_IO_URING_SUPPORTED
+	auto& buf = RecvBufferRing[RecvBufferRingTail & (RecvBufferCount - 1)];
+
+	buf.addr = reinterpret_cast<uint64_t>(RecvBuffers + (bufferId * RecvBufferSize));
+	buf.len  = RecvBufferSize;
+	buf.bid  = bufferId;
+
+	++RecvBufferRingTail;
+
+	__atomic_store_n(&RecvBufferRing[0].resv, RecvBufferRingTail, __ATOMIC_RELEASE);
+#endif
+}
+
+inline void DepLibUring::OnUvEventFdReadable()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING_SUPPORTED
+	uint64_t value;
+
+	// Just clear it.
+	while (read(DepLibUring::eventFd, &value, sizeof(value)) > 0)
+	{
+	}
+
+	DepLibUring::ReapCompletions();
+
+	// Submit the receive requests that have been armed again.
+	DepLibUring::Submit();
+#endif
+}
+
+inline void DepLibUring::OnUvLoopIteration()
+{
+	if (!DepLibUring::active)
+		return;
+
+	DepLibUring::ReapCompletions();
+	DepLibUring::Submit();
+}
@@ -0,0 +1,5 @@
+#include "MediaSoupErrors.hpp"
+
+/* Class variables. */
+
+thread_local char MediaSoupError::buffer[MediaSoupError::bufferSize];
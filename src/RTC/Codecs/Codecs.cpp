@@ -47,5 +47,112 @@ namespace RTC
 				default:;
 			}
 		}
+
+		/* PayloadDescriptorHandler methods. */
+
+		void PayloadDescriptorHandler::Dump() const
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				case Codec::VP8:
+					GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->Dump();
+					break;
+				case Codec::VP9:
+					GetHandler<RTC::Codecs::VP9::PayloadDescriptorHandler>()->Dump();
+					break;
+				case Codec::H264:
+					GetHandler<RTC::Codecs::H264::PayloadDescriptorHandler>()->Dump();
+					break;
+				default:;
+			}
+		}
+
+		bool PayloadDescriptorHandler::Process(
+		  RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker)
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				case Codec::VP8:
+					return GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->Process(
+					  context, data, marker);
+				case Codec::VP9:
+					return GetHandler<RTC::Codecs::VP9::PayloadDescriptorHandler>()->Process(
+					  context, data, marker);
+				case Codec::H264:
+					return GetHandler<RTC::Codecs::H264::PayloadDescriptorHandler>()->Process(
+					  context, data, marker);
+				default:
+					return true;
+			}
+		}
+
+		void PayloadDescriptorHandler::Restore(uint8_t* data)
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				case Codec::VP8:
+					GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->Restore(data);
+					break;
+				case Codec::VP9:
+					GetHandler<RTC::Codecs::VP9::PayloadDescriptorHandler>()->Restore(data);
+					break;
+				case Codec::H264:
+					GetHandler<RTC::Codecs::H264::PayloadDescriptorHandler>()->Restore(data);
+					break;
+				default:;
+			}
+		}
+
+		size_t PayloadDescriptorHandler::GetNumProcessed() const
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				// Only VP8 rewrites the payload (pictureId and tl0PictureIndex).
+				case Codec::VP8:
+					return GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->GetNumProcessed();
+				default:
+					return 0u;
+			}
+		}
+
+		size_t PayloadDescriptorHandler::GetNumRewrites() const
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				// Only VP8 rewrites the payload (pictureId and tl0PictureIndex).
+				case Codec::VP8:
+					return GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->GetNumRewrites();
+				default:
+					return 0u;
+			}
+		}
+
+		/**
+		 * Value that changes whenever the payload bytes are rewritten (for the
+		 * same packet), so rewrites can be told apart without comparing the payload.
+		 */
+		uint32_t PayloadDescriptorHandler::GetPayloadState() const
+		{
+			MS_TRACE();
+
+			switch (this->codec)
+			{
+				// Only VP8 rewrites the payload (pictureId and tl0PictureIndex).
+				case Codec::VP8:
+					return GetHandler<RTC::Codecs::VP8::PayloadDescriptorHandler>()->GetPayloadState();
+				default:
+					return 0u;
+			}
+		}
 	} // namespace Codecs
 } // namespace RTC
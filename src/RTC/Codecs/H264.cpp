@@ -11,44 +11,46 @@ namespace RTC
 	{
 		/* Class methods. */
 
-		H264::PayloadDescriptor* H264::Parse(
-		  const uint8_t* data, size_t len, RTC::RtpPacket::FrameMarking* frameMarking, uint8_t frameMarkingLen)
+		bool H264::Parse(
+		  const uint8_t* data,
+		  size_t len,
+		  PayloadDescriptor& payloadDescriptor,
+		  RTC::RtpPacket::FrameMarking* frameMarking,
+		  uint8_t frameMarkingLen)
 		{
 			MS_TRACE();
 
 			if (len < 2)
-				return nullptr;
-
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+				return false;
 
 			// Use frame-marking.
 			if (frameMarking)
 			{
 				// Read fields.
-				payloadDescriptor->s   = frameMarking->start;
-				payloadDescriptor->e   = frameMarking->end;
-				payloadDescriptor->i   = frameMarking->independent;
-				payloadDescriptor->d   = frameMarking->discardable;
-				payloadDescriptor->b   = frameMarking->base;
-				payloadDescriptor->tid = frameMarking->tid;
+				payloadDescriptor.s   = frameMarking->start;
+				payloadDescriptor.e   = frameMarking->end;
+				payloadDescriptor.i   = frameMarking->independent;
+				payloadDescriptor.d   = frameMarking->discardable;
+				payloadDescriptor.b   = frameMarking->base;
+				payloadDescriptor.tid = frameMarking->tid;
 
-				payloadDescriptor->hasTid = true;
+				payloadDescriptor.hasTid = true;
 
 				if (frameMarkingLen >= 2)
 				{
-					payloadDescriptor->hasLid = true;
-					payloadDescriptor->lid    = frameMarking->lid;
+					payloadDescriptor.hasLid = true;
+					payloadDescriptor.lid    = frameMarking->lid;
 				}
 
 				if (frameMarkingLen == 3)
 				{
-					payloadDescriptor->hasTl0picidx = true;
-					payloadDescriptor->tl0picidx    = frameMarking->tl0picidx;
+					payloadDescriptor.hasTl0picidx = true;
+					payloadDescriptor.tl0picidx    = frameMarking->tl0picidx;
 				}
 
 				// Detect key frame.
 				if (frameMarking->start && frameMarking->independent)
-					payloadDescriptor->isKeyFrame = true;
+					payloadDescriptor.isKeyFrame = true;
 			}
 
 			// NOTE: Unfortunately libwebrtc produces wrong Frame-Marking (without i=1 in
@@ -57,7 +59,7 @@ namespace RTC
 			//
 			// As a temporal workaround, always do payload parsing to detect keyframes if
 			// there is no frame-marking or if there is but keyframe was not detected above.
-			if (!frameMarking || !payloadDescriptor->isKeyFrame)
+			if (!frameMarking || !payloadDescriptor.isKeyFrame)
 			{
 				uint8_t nal = *data & 0x1F;
 
@@ -67,7 +69,7 @@ namespace RTC
 					// IDR (instantaneous decoding picture).
 					case 7:
 					{
-						payloadDescriptor->isKeyFrame = true;
+						payloadDescriptor.isKeyFrame = true;
 
 						break;
 					}
@@ -88,7 +90,7 @@ namespace RTC
 
 							if (subnal == 7)
 							{
-								payloadDescriptor->isKeyFrame = true;
+								payloadDescriptor.isKeyFrame = true;
 
 								break;
 							}
@@ -113,14 +115,14 @@ namespace RTC
 						uint8_t startBit = *(data + 1) & 0x80;
 
 						if (subnal == 7 && startBit == 128)
-							payloadDescriptor->isKeyFrame = true;
+							payloadDescriptor.isKeyFrame = true;
 
 						break;
 					}
 				}
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void H264::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -135,14 +137,13 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = H264::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!H264::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 				return;
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+			packet->SetPayloadDescriptorHandler<PayloadDescriptorHandler>(
+			  RTC::Codecs::PayloadDescriptorHandler::Codec::H264, payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -169,13 +170,6 @@ namespace RTC
 			MS_DUMP("</PayloadDescriptor>");
 		}
 
-		H264::PayloadDescriptorHandler::PayloadDescriptorHandler(H264::PayloadDescriptor* payloadDescriptor)
-		{
-			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
-		}
-
 		bool H264::PayloadDescriptorHandler::Process(
 		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* /*data*/, bool& /*marker*/)
 		{
@@ -186,15 +180,15 @@ namespace RTC
 			MS_ASSERT(context->GetTargetTemporalLayer() >= 0, "target temporal layer cannot be -1");
 
 			// Check if the payload should contain temporal layer info.
-			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor->hasTid)
+			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor.hasTid)
 			{
 				MS_WARN_DEV("stream is supposed to have >1 temporal layers but does not have tid field");
 			}
 
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetTargetTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetTargetTemporalLayer()
 			)
 			// clang-format on
 			{
@@ -206,9 +200,9 @@ namespace RTC
 			//
 			// clang-format off
 			// else if (
-			// 	this->payloadDescriptor->hasTid &&
-			// 	this->payloadDescriptor->tid > context->GetCurrentTemporalLayer() &&
-			// 	!this->payloadDescriptor->b
+			// 	this->payloadDescriptor.hasTid &&
+			// 	this->payloadDescriptor.tid > context->GetCurrentTemporalLayer() &&
+			// 	!this->payloadDescriptor.b
 			// )
 			// // clang-format on
 			// {
@@ -218,14 +212,14 @@ namespace RTC
 			// Update/fix current temporal layer.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTid &&
-				this->payloadDescriptor->tid > context->GetCurrentTemporalLayer()
+				this->payloadDescriptor.hasTid &&
+				this->payloadDescriptor.tid > context->GetCurrentTemporalLayer()
 			)
 			// clang-format on
 			{
-				context->SetCurrentTemporalLayer(this->payloadDescriptor->tid);
+				context->SetCurrentTemporalLayer(this->payloadDescriptor.tid);
 			}
-			else if (!this->payloadDescriptor->hasTid)
+			else if (!this->payloadDescriptor.hasTid)
 			{
 				context->SetCurrentTemporalLayer(0);
 			}
@@ -11,104 +11,103 @@ namespace RTC
 	{
 		/* Class methods. */
 
-		VP8::PayloadDescriptor* VP8::Parse(
+		bool VP8::Parse(
 		  const uint8_t* data,
 		  size_t len,
+		  PayloadDescriptor& payloadDescriptor,
 		  RTC::RtpPacket::FrameMarking* /*frameMarking*/,
 		  uint8_t /*frameMarkingLen*/)
 		{
 			MS_TRACE();
 
 			if (len < 1)
-				return nullptr;
-
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+				return false;
 
 			size_t offset{ 0 };
 			uint8_t byte = data[offset];
 
-			payloadDescriptor->extended       = (byte >> 7) & 0x01;
-			payloadDescriptor->nonReference   = (byte >> 5) & 0x01;
-			payloadDescriptor->start          = (byte >> 4) & 0x01;
-			payloadDescriptor->partitionIndex = byte & 0x07;
+			payloadDescriptor.extended       = (byte >> 7) & 0x01;
+			payloadDescriptor.nonReference   = (byte >> 5) & 0x01;
+			payloadDescriptor.start          = (byte >> 4) & 0x01;
+			payloadDescriptor.partitionIndex = byte & 0x07;
 
-			if (!payloadDescriptor->extended)
+			if (!payloadDescriptor.extended)
 			{
-				return nullptr;
+				return false;
 			}
 			else
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				byte = data[offset];
 
-				payloadDescriptor->i = (byte >> 7) & 0x01;
-				payloadDescriptor->l = (byte >> 6) & 0x01;
-				payloadDescriptor->t = (byte >> 5) & 0x01;
-				payloadDescriptor->k = (byte >> 4) & 0x01;
+				payloadDescriptor.i = (byte >> 7) & 0x01;
+				payloadDescriptor.l = (byte >> 6) & 0x01;
+				payloadDescriptor.t = (byte >> 5) & 0x01;
+				payloadDescriptor.k = (byte >> 4) & 0x01;
 			}
 
-			if (payloadDescriptor->i)
+			if (payloadDescriptor.i)
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				byte = data[offset];
 
 				if ((byte >> 7) & 0x01)
 				{
 					if (len < ++offset + 1)
-						return nullptr;
+						return false;
 
-					payloadDescriptor->hasTwoBytesPictureId = true;
-					payloadDescriptor->pictureId            = (byte & 0x7F) << 8;
-					payloadDescriptor->pictureId += data[offset];
+					payloadDescriptor.hasTwoBytesPictureId = true;
+					payloadDescriptor.pictureId            = (byte & 0x7F) << 8;
+					payloadDescriptor.pictureId += data[offset];
 				}
 				else
 				{
-					payloadDescriptor->hasOneBytePictureId = true;
-					payloadDescriptor->pictureId           = byte & 0x7F;
+					payloadDescriptor.hasOneBytePictureId = true;
+					payloadDescriptor.pictureId           = byte & 0x7F;
 				}
 
-				payloadDescriptor->hasPictureId = true;
+				payloadDescriptor.hasPictureId = true;
 			}
 
-			if (payloadDescriptor->l)
+			if (payloadDescriptor.l)
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
-				payloadDescriptor->hasTl0PictureIndex = true;
-				payloadDescriptor->tl0PictureIndex    = data[offset];
+				payloadDescriptor.hasTl0PictureIndex = true;
+				payloadDescriptor.tl0PictureIndex    = data[offset];
 			}
 
-			if (payloadDescriptor->t || payloadDescriptor->k)
+			if (payloadDescriptor.t || payloadDescriptor.k)
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				byte = data[offset];
 
-				payloadDescriptor->hasTlIndex = true;
-				payloadDescriptor->tlIndex    = (byte >> 6) & 0x03;
-				payloadDescriptor->y          = (byte >> 5) & 0x01;
-				payloadDescriptor->keyIndex   = byte & 0x1F;
+				payloadDescriptor.hasTlIndex = true;
+				payloadDescriptor.tlIndex    = (byte >> 6) & 0x03;
+				payloadDescriptor.y          = (byte >> 5) & 0x01;
+				payloadDescriptor.keyIndex   = byte & 0x1F;
 			}
 
 			// clang-format off
 			if (
 				(len >= ++offset + 1) &&
-				payloadDescriptor->start &&
-				payloadDescriptor->partitionIndex == 0 &&
+				payloadDescriptor.start &&
+				payloadDescriptor.partitionIndex == 0 &&
 				(!(data[offset] & 0x01))
 			)
 			// clang-format on
 			{
-				payloadDescriptor->isKeyFrame = true;
+				payloadDescriptor.isKeyFrame = true;
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void VP8::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -123,17 +122,13 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = VP8::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!VP8::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 				return;
 
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
-
 			// Modify the RtpPacket payload in order to always have two byte pictureId.
-			if (payloadDescriptor->hasOneBytePictureId)
+			if (payloadDescriptor.hasOneBytePictureId)
 			{
 				// Shift the RTP payload one byte from the begining of the pictureId field.
 				packet->ShiftPayload(2, 1, true /*expand*/);
@@ -142,9 +137,12 @@ namespace RTC
 				data[2] = 0x80;
 
 				// Update the payloadDescriptor.
-				payloadDescriptor->hasOneBytePictureId  = false;
-				payloadDescriptor->hasTwoBytesPictureId = true;
+				payloadDescriptor.hasOneBytePictureId  = false;
+				payloadDescriptor.hasTwoBytesPictureId = true;
 			}
+
+			packet->SetPayloadDescriptorHandler<PayloadDescriptorHandler>(
+			  RTC::Codecs::PayloadDescriptorHandler::Codec::VP8, payloadDescriptor);
 		}
 
 		/* Instance methods. */
@@ -215,13 +213,6 @@ namespace RTC
 			Encode(data, this->pictureId, this->tl0PictureIndex);
 		}
 
-		VP8::PayloadDescriptorHandler::PayloadDescriptorHandler(VP8::PayloadDescriptor* payloadDescriptor)
-		{
-			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
-		}
-
 		bool VP8::PayloadDescriptorHandler::Process(
 		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& /*marker*/)
 		{
@@ -232,7 +223,7 @@ namespace RTC
 			MS_ASSERT(context->GetTargetTemporalLayer() >= 0, "target temporal layer cannot be -1");
 
 			// Check if the payload should contain temporal layer info.
-			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor->hasTlIndex)
+			if (context->GetTemporalLayers() > 1 && !this->payloadDescriptor.hasTlIndex)
 			{
 				MS_WARN_DEV("stream is supposed to have >1 temporal layers but does not have TlIndex field");
 			}
@@ -241,13 +232,13 @@ namespace RTC
 			// clang-format off
 			if (
 				context->syncRequired &&
-				this->payloadDescriptor->hasPictureId &&
-				this->payloadDescriptor->hasTl0PictureIndex
+				this->payloadDescriptor.hasPictureId &&
+				this->payloadDescriptor.hasTl0PictureIndex
 			)
 			// clang-format on
 			{
-				context->pictureIdManager.Sync(this->payloadDescriptor->pictureId - 1);
-				context->tl0PictureIndexManager.Sync(this->payloadDescriptor->tl0PictureIndex - 1);
+				context->pictureIdManager.Sync(this->payloadDescriptor.pictureId - 1);
+				context->tl0PictureIndexManager.Sync(this->payloadDescriptor.tl0PictureIndex - 1);
 
 				context->syncRequired = false;
 			}
@@ -255,32 +246,32 @@ namespace RTC
 			// Incremental pictureId. Check the temporal layer.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasPictureId &&
-				this->payloadDescriptor->hasTlIndex &&
-				this->payloadDescriptor->hasTl0PictureIndex &&
+				this->payloadDescriptor.hasPictureId &&
+				this->payloadDescriptor.hasTlIndex &&
+				this->payloadDescriptor.hasTl0PictureIndex &&
 				!RTC::SeqManager<uint16_t>::IsSeqLowerThan(
-					this->payloadDescriptor->pictureId,
+					this->payloadDescriptor.pictureId,
 					context->pictureIdManager.GetMaxInput())
 			)
 			// clang-format on
 			{
-				if (this->payloadDescriptor->tlIndex > context->GetTargetTemporalLayer())
+				if (this->payloadDescriptor.tlIndex > context->GetTargetTemporalLayer())
 				{
-					context->pictureIdManager.Drop(this->payloadDescriptor->pictureId);
-					context->tl0PictureIndexManager.Drop(this->payloadDescriptor->tl0PictureIndex);
+					context->pictureIdManager.Drop(this->payloadDescriptor.pictureId);
+					context->tl0PictureIndexManager.Drop(this->payloadDescriptor.tl0PictureIndex);
 
 					return false;
 				}
 				// Upgrade required. Drop current packet if sync flag is not set.
 				// clang-format off
 				else if (
-					this->payloadDescriptor->tlIndex > context->GetCurrentTemporalLayer() &&
-					!this->payloadDescriptor->y
+					this->payloadDescriptor.tlIndex > context->GetCurrentTemporalLayer() &&
+					!this->payloadDescriptor.y
 				)
 				// clang-format on
 				{
-					context->pictureIdManager.Drop(this->payloadDescriptor->pictureId);
-					context->tl0PictureIndexManager.Drop(this->payloadDescriptor->tl0PictureIndex);
+					context->pictureIdManager.Drop(this->payloadDescriptor.pictureId);
+					context->tl0PictureIndexManager.Drop(this->payloadDescriptor.tl0PictureIndex);
 
 					return false;
 				}
@@ -293,8 +284,8 @@ namespace RTC
 			// Do not send a dropped pictureId.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasPictureId &&
-				!context->pictureIdManager.Input(this->payloadDescriptor->pictureId, pictureId)
+				this->payloadDescriptor.hasPictureId &&
+				!context->pictureIdManager.Input(this->payloadDescriptor.pictureId, pictureId)
 			)
 			// clang-format on
 			{
@@ -304,9 +295,9 @@ namespace RTC
 			// Do not send a dropped tl0PictureIndex.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTl0PictureIndex &&
+				this->payloadDescriptor.hasTl0PictureIndex &&
 				!context->tl0PictureIndexManager.Input(
-					this->payloadDescriptor->tl0PictureIndex, tl0PictureIndex)
+					this->payloadDescriptor.tl0PictureIndex, tl0PictureIndex)
 			)
 			// clang-format on
 			{
@@ -316,14 +307,14 @@ namespace RTC
 			// Update/fix current temporal layer.
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasTlIndex &&
-				this->payloadDescriptor->tlIndex > context->GetCurrentTemporalLayer()
+				this->payloadDescriptor.hasTlIndex &&
+				this->payloadDescriptor.tlIndex > context->GetCurrentTemporalLayer()
 			)
 			// clang-format on
 			{
-				context->SetCurrentTemporalLayer(this->payloadDescriptor->tlIndex);
+				context->SetCurrentTemporalLayer(this->payloadDescriptor.tlIndex);
 			}
-			else if (!this->payloadDescriptor->hasTlIndex)
+			else if (!this->payloadDescriptor.hasTlIndex)
 			{
 				context->SetCurrentTemporalLayer(0);
 			}
@@ -333,14 +324,31 @@ namespace RTC
 
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasPictureId &&
-				this->payloadDescriptor->hasTl0PictureIndex
+				this->payloadDescriptor.hasPictureId &&
+				this->payloadDescriptor.hasTl0PictureIndex
 			)
 			// clang-format on
 			{
-				this->payloadDescriptor->Encode(data, pictureId, tl0PictureIndex);
+				// The payload is not restored between consumers, so consumers whose
+				// encoding contexts are in the same state (same layers and same
+				// pictureId and tl0PictureIndex offsets) share a single rewrite.
+				// clang-format off
+				if (
+					pictureId != this->encodedPictureId ||
+					tl0PictureIndex != this->encodedTl0PictureIndex
+				)
+				// clang-format on
+				{
+					this->payloadDescriptor.Encode(data, pictureId, tl0PictureIndex);
+
+					this->encodedPictureId       = pictureId;
+					this->encodedTl0PictureIndex = tl0PictureIndex;
+					++this->numRewrites;
+				}
 			}
 
+			++this->numProcessed;
+
 			return true;
 		};
 
@@ -350,12 +358,19 @@ namespace RTC
 
 			// clang-format off
 			if (
-				this->payloadDescriptor->hasPictureId &&
-				this->payloadDescriptor->hasTl0PictureIndex
+				this->payloadDescriptor.hasPictureId &&
+				this->payloadDescriptor.hasTl0PictureIndex &&
+				(
+					this->encodedPictureId != this->payloadDescriptor.pictureId ||
+					this->encodedTl0PictureIndex != this->payloadDescriptor.tl0PictureIndex
+				)
 			)
 			// clang-format on
 			{
-				this->payloadDescriptor->Restore(data);
+				this->payloadDescriptor.Restore(data);
+
+				this->encodedPictureId       = this->payloadDescriptor.pictureId;
+				this->encodedTl0PictureIndex = this->payloadDescriptor.tl0PictureIndex;
 			}
 		}
 	} // namespace Codecs
@@ -10,92 +10,91 @@ namespace RTC
 	{
 		/* Class methods. */
 
-		VP9::PayloadDescriptor* VP9::Parse(
+		bool VP9::Parse(
 		  const uint8_t* data,
 		  size_t len,
+		  PayloadDescriptor& payloadDescriptor,
 		  RTC::RtpPacket::FrameMarking* /*frameMarking*/,
 		  uint8_t /*frameMarkingLen*/)
 		{
 			MS_TRACE();
 
 			if (len < 1)
-				return nullptr;
-
-			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+				return false;
 
 			size_t offset{ 0 };
 			uint8_t byte = data[offset];
 
-			payloadDescriptor->i = (byte >> 7) & 0x01;
-			payloadDescriptor->p = (byte >> 6) & 0x01;
-			payloadDescriptor->l = (byte >> 5) & 0x01;
-			payloadDescriptor->f = (byte >> 4) & 0x01;
-			payloadDescriptor->b = (byte >> 3) & 0x01;
-			payloadDescriptor->e = (byte >> 2) & 0x01;
-			payloadDescriptor->v = (byte >> 1) & 0x01;
+			payloadDescriptor.i = (byte >> 7) & 0x01;
+			payloadDescriptor.p = (byte >> 6) & 0x01;
+			payloadDescriptor.l = (byte >> 5) & 0x01;
+			payloadDescriptor.f = (byte >> 4) & 0x01;
+			payloadDescriptor.b = (byte >> 3) & 0x01;
+			payloadDescriptor.e = (byte >> 2) & 0x01;
+			payloadDescriptor.v = (byte >> 1) & 0x01;
 
-			if (payloadDescriptor->i)
+			if (payloadDescriptor.i)
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				byte = data[offset];
 
 				if (byte >> 7 & 0x01)
 				{
 					if (len < ++offset + 1)
-						return nullptr;
+						return false;
 
-					payloadDescriptor->pictureId = (byte & 0x7F) << 8;
-					payloadDescriptor->pictureId += data[offset];
-					payloadDescriptor->hasTwoBytesPictureId = true;
+					payloadDescriptor.pictureId = (byte & 0x7F) << 8;
+					payloadDescriptor.pictureId += data[offset];
+					payloadDescriptor.hasTwoBytesPictureId = true;
 				}
 				else
 				{
-					payloadDescriptor->pictureId           = byte & 0x7F;
-					payloadDescriptor->hasOneBytePictureId = true;
+					payloadDescriptor.pictureId           = byte & 0x7F;
+					payloadDescriptor.hasOneBytePictureId = true;
 				}
 
-				payloadDescriptor->hasPictureId = true;
+				payloadDescriptor.hasPictureId = true;
 			}
 
-			if (payloadDescriptor->l)
+			if (payloadDescriptor.l)
 			{
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				byte = data[offset];
 
-				payloadDescriptor->interLayerDependency = byte & 0x01;
-				payloadDescriptor->switchingUpPoint     = byte >> 4 & 0x01;
-				payloadDescriptor->slIndex              = byte >> 1 & 0x07;
-				payloadDescriptor->tlIndex              = byte >> 5 & 0x07;
-				payloadDescriptor->hasSlIndex           = true;
-				payloadDescriptor->hasTlIndex           = true;
+				payloadDescriptor.interLayerDependency = byte & 0x01;
+				payloadDescriptor.switchingUpPoint     = byte >> 4 & 0x01;
+				payloadDescriptor.slIndex              = byte >> 1 & 0x07;
+				payloadDescriptor.tlIndex              = byte >> 5 & 0x07;
+				payloadDescriptor.hasSlIndex           = true;
+				payloadDescriptor.hasTlIndex           = true;
 
 				if (len < ++offset + 1)
-					return nullptr;
+					return false;
 
 				// Read TL0PICIDX if flexible mode is unset.
-				if (!payloadDescriptor->f)
+				if (!payloadDescriptor.f)
 				{
-					payloadDescriptor->tl0PictureIndex    = data[offset];
-					payloadDescriptor->hasTl0PictureIndex = true;
+					payloadDescriptor.tl0PictureIndex    = data[offset];
+					payloadDescriptor.hasTl0PictureIndex = true;
 				}
 			}
 
 			// clang-format off
 			if (
-				!payloadDescriptor->p &&
-				payloadDescriptor->b &&
-				payloadDescriptor->slIndex == 0
+				!payloadDescriptor.p &&
+				payloadDescriptor.b &&
+				payloadDescriptor.slIndex == 0
 			)
 			// clang-format on
 			{
-				payloadDescriptor->isKeyFrame = true;
+				payloadDescriptor.isKeyFrame = true;
 			}
 
-			return payloadDescriptor.release();
+			return true;
 		}
 
 		void VP9::ProcessRtpPacket(RTC::RtpPacket* packet)
@@ -110,22 +109,21 @@ namespace RTC
 			// Read frame-marking.
 			packet->ReadFrameMarking(&frameMarking, frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = VP9::Parse(data, len, frameMarking, frameMarkingLen);
+			PayloadDescriptor payloadDescriptor{};
 
-			if (!payloadDescriptor)
+			if (!VP9::Parse(data, len, payloadDescriptor, frameMarking, frameMarkingLen))
 				return;
 
-			if (payloadDescriptor->isKeyFrame)
+			packet->SetPayloadDescriptorHandler<PayloadDescriptorHandler>(
+			  RTC::Codecs::PayloadDescriptorHandler::Codec::VP9, payloadDescriptor);
+
+			if (payloadDescriptor.isKeyFrame)
 			{
 				MS_DEBUG_DEV(
 				  "key frame [spatialLayer:%" PRIu8 ", temporalLayer:%" PRIu8 "]",
 				  packet->GetSpatialLayer(),
 				  packet->GetTemporalLayer());
 			}
-
-			auto* payloadDescriptorHandler = new PayloadDescriptorHandler(payloadDescriptor);
-
-			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
 		}
 
 		/* Instance methods. */
@@ -160,13 +158,6 @@ namespace RTC
 			MS_DUMP("</PayloadDescriptor>");
 		}
 
-		VP9::PayloadDescriptorHandler::PayloadDescriptorHandler(VP9::PayloadDescriptor* payloadDescriptor)
-		{
-			MS_TRACE();
-
-			this->payloadDescriptor.reset(payloadDescriptor);
-		}
-
 		bool VP9::PayloadDescriptorHandler::Process(
 		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* /*data*/, bool& marker)
 		{
@@ -201,20 +192,20 @@ namespace RTC
 			// clang-format off
 			if (
 				context->syncRequired &&
-				this->payloadDescriptor->hasPictureId
+				this->payloadDescriptor.hasPictureId
 			)
 			// clang-format on
 			{
-				context->pictureIdManager.Sync(this->payloadDescriptor->pictureId - 1);
+				context->pictureIdManager.Sync(this->payloadDescriptor.pictureId - 1);
 
 				context->syncRequired = false;
 			}
 
 			// clang-format off
 			bool isOldPacket = (
-				this->payloadDescriptor->hasPictureId &&
+				this->payloadDescriptor.hasPictureId &&
 				RTC::SeqManager<uint16_t>::IsSeqLowerThan(
-					this->payloadDescriptor->pictureId,
+					this->payloadDescriptor.pictureId,
 					context->pictureIdManager.GetMaxInput())
 			);
 			// clang-format on
@@ -222,7 +213,7 @@ namespace RTC
 			// Upgrade current spatial layer if needed.
 			if (context->GetTargetSpatialLayer() > context->GetCurrentSpatialLayer())
 			{
-				if (this->payloadDescriptor->isKeyFrame)
+				if (this->payloadDescriptor.isKeyFrame)
 				{
 					MS_DEBUG_DEV(
 					  "upgrading tmpSpatialLayer from %" PRIu16 " to %" PRIu16 " (packet:%" PRIu8 ":%" PRIu8
@@ -242,7 +233,7 @@ namespace RTC
 				// In K-SVC we must wait for a keyframe.
 				if (context->IsKSvc())
 				{
-					if (this->payloadDescriptor->isKeyFrame)
+					if (this->payloadDescriptor.isKeyFrame)
 					// clang-format on
 					{
 						MS_DEBUG_DEV(
@@ -263,7 +254,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetSpatialLayer == context->GetTargetSpatialLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -296,9 +287,9 @@ namespace RTC
 						packetTemporalLayer >= context->GetCurrentTemporalLayer() + 1 &&
 						(
 							context->GetCurrentTemporalLayer() == -1 ||
-							this->payloadDescriptor->switchingUpPoint
+							this->payloadDescriptor.switchingUpPoint
 						) &&
-						this->payloadDescriptor->b
+						this->payloadDescriptor.b
 					)
 					// clang-format on
 					{
@@ -319,7 +310,7 @@ namespace RTC
 					// clang-format off
 					if (
 						packetTemporalLayer == context->GetTargetTemporalLayer() &&
-						this->payloadDescriptor->e
+						this->payloadDescriptor.e
 					)
 					// clang-format on
 					{
@@ -341,15 +332,15 @@ namespace RTC
 			}
 
 			// Set marker bit if needed.
-			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor->e)
+			if (packetSpatialLayer == tmpSpatialLayer && this->payloadDescriptor.e)
 				marker = true;
 
 			// Update the pictureId manager.
-			if (this->payloadDescriptor->hasPictureId)
+			if (this->payloadDescriptor.hasPictureId)
 			{
 				uint16_t pictureId;
 
-				context->pictureIdManager.Input(this->payloadDescriptor->pictureId, pictureId);
+				context->pictureIdManager.Input(this->payloadDescriptor.pictureId, pictureId);
 			}
 
 			// Update current spatial layer if needed.
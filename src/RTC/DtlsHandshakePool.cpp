@@ -0,0 +1,213 @@
+#define MS_CLASS "RTC::DtlsHandshakePool"
+// #define MS_LOG_DEV
+
+#include "RTC/DtlsHandshakePool.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t JobsQueueSize{ 1024 };
+	static constexpr size_t MessagesQueueSize{ 1024 };
+
+	/* Static methods for UV callbacks. */
+
+	inline static void onAsync(uv_async_t* /*handle*/)
+	{
+		DtlsHandshakePool::OnUvJobsDone();
+	}
+
+	inline static void onClose(uv_handle_t* handle)
+	{
+		delete handle;
+	}
+
+	/* Class variables. */
+
+	thread_local uv_async_t* DtlsHandshakePool::uvHandle{ nullptr };
+	thread_local std::vector<DtlsHandshakePool::HandshakeThread*> DtlsHandshakePool::threads;
+	thread_local size_t DtlsHandshakePool::nextThreadIdx{ 0 };
+
+	/* Class methods. */
+
+	void DtlsHandshakePool::ClassInit()
+	{
+		MS_TRACE();
+
+		if (Settings::configuration.dtlsHandshakeThreads == 0)
+			return;
+
+		DtlsHandshakePool::uvHandle = new uv_async_t;
+
+		int err = uv_async_init(
+		  DepLibUV::GetLoop(), DtlsHandshakePool::uvHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete DtlsHandshakePool::uvHandle;
+			DtlsHandshakePool::uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		// It must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(DtlsHandshakePool::uvHandle));
+
+		try
+		{
+			for (size_t idx{ 0 }; idx < Settings::configuration.dtlsHandshakeThreads; ++idx)
+			{
+				DtlsHandshakePool::threads.push_back(new HandshakeThread(DtlsHandshakePool::uvHandle));
+			}
+		}
+		catch (const MediaSoupError& /*error*/)
+		{
+			ClassDestroy();
+
+			throw;
+		}
+	}
+
+	void DtlsHandshakePool::ClassDestroy()
+	{
+		MS_TRACE();
+
+		if (!DtlsHandshakePool::uvHandle)
+			return;
+
+		// Threads process the jobs given to them before ending. Jobs of closed
+		// DtlsTransports are handed back to be deleted.
+		for (auto* thread : DtlsHandshakePool::threads)
+		{
+			delete thread;
+		}
+		DtlsHandshakePool::threads.clear();
+
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(DtlsHandshakePool::uvHandle), static_cast<uv_close_cb>(onClose));
+		DtlsHandshakePool::uvHandle = nullptr;
+	}
+
+	void DtlsHandshakePool::Submit(RTC::DtlsTransport::HandshakeJob* job)
+	{
+		MS_TRACE();
+
+		auto& threads = DtlsHandshakePool::threads;
+
+		threads[DtlsHandshakePool::nextThreadIdx]->Submit(job);
+
+		DtlsHandshakePool::nextThreadIdx = (DtlsHandshakePool::nextThreadIdx + 1) % threads.size();
+	}
+
+	void DtlsHandshakePool::OnUvJobsDone()
+	{
+		MS_TRACE();
+
+		for (auto* thread : DtlsHandshakePool::threads)
+		{
+			thread->DeliverMessages();
+			thread->DeliverJobs();
+		}
+	}
+
+	/* Instance methods of HandshakeThread. */
+
+	// NOTE: Messages are dropped if the loop does not keep up since the thread
+	// must not block.
+	DtlsHandshakePool::HandshakeThread::HandshakeThread(uv_async_t* uvHandle)
+	  : ChannelThread(Logger::channel, MessagesQueueSize, ChannelThread::QueueFullPolicy::DROP),
+	    uvHandle(uvHandle), jobs(JobsQueueSize), doneJobs(JobsQueueSize)
+	{
+		MS_TRACE();
+
+		uv_sem_init(&this->sem, 0);
+
+		try
+		{
+			Start();
+		}
+		catch (const MediaSoupError& /*error*/)
+		{
+			uv_sem_destroy(&this->sem);
+
+			throw;
+		}
+	}
+
+	DtlsHandshakePool::HandshakeThread::~HandshakeThread()
+	{
+		MS_TRACE();
+
+		this->stopping.store(true);
+		uv_sem_post(&this->sem);
+		Join();
+		uv_sem_destroy(&this->sem);
+
+		DeliverMessages();
+		DeliverJobs();
+	}
+
+	/**
+	 * Called from the loop thread.
+	 */
+	void DtlsHandshakePool::HandshakeThread::Submit(RTC::DtlsTransport::HandshakeJob* job)
+	{
+		MS_TRACE();
+
+		// Each DtlsTransport has a single job at a time so this should not wait.
+		this->jobs.PushWait(std::move(job));
+
+		uv_sem_post(&this->sem);
+	}
+
+	/**
+	 * Called from the loop thread.
+	 */
+	void DtlsHandshakePool::HandshakeThread::DeliverJobs()
+	{
+		MS_TRACE();
+
+		RTC::DtlsTransport::HandshakeJob* job;
+
+		while (this->doneJobs.Pop(job))
+		{
+			RTC::DtlsTransport::OnHandshakeJobDone(job);
+		}
+	}
+
+	/**
+	 * Called from the thread. The async handle belongs to the loop that owns the
+	 * pool (the thread has no loop of its own).
+	 */
+	void DtlsHandshakePool::HandshakeThread::NotifyLoop()
+	{
+		uv_async_send(this->uvHandle);
+	}
+
+	void DtlsHandshakePool::HandshakeThread::UserOnThread()
+	{
+		while (true)
+		{
+			uv_sem_wait(&this->sem);
+
+			RTC::DtlsTransport::HandshakeJob* job;
+
+			while (this->jobs.Pop(job))
+			{
+				RTC::DtlsTransport::RunHandshakeJob(job);
+
+				// The loop drains the queue so it will have room soon.
+				this->doneJobs.PushWait(std::move(job));
+
+				NotifyLoop();
+			}
+
+			if (this->stopping.load())
+				break;
+		}
+	}
+} // namespace RTC
@@ -6,6 +6,7 @@
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
+#include "RTC/DtlsHandshakePool.hpp"
 #include <openssl/asn1.h>
 #include <openssl/bn.h>
 #include <openssl/err.h>
@@ -63,6 +64,7 @@ namespace RTC
 	// clang-format off
 	static constexpr int DtlsMtu{ 1350 };
 	static constexpr int SslReadBufferSize{ 65536 };
+	static constexpr size_t MaxPendingDtlsData{ 16 };
 	// AES-HMAC: http://tools.ietf.org/html/rfc3711
 	static constexpr size_t SrtpMasterKeyLength{ 16 };
 	static constexpr size_t SrtpMasterSaltLength{ 14 };
@@ -81,7 +83,7 @@ namespace RTC
 	X509* DtlsTransport::certificate{ nullptr };
 	EVP_PKEY* DtlsTransport::privateKey{ nullptr };
 	SSL_CTX* DtlsTransport::sslCtx{ nullptr };
-	uint8_t DtlsTransport::sslReadBuffer[SslReadBufferSize];
+	thread_local uint8_t DtlsTransport::sslReadBuffer[SslReadBufferSize];
 	// clang-format off
 	std::map<std::string, DtlsTransport::FingerprintAlgorithm> DtlsTransport::string2FingerprintAlgorithm =
 	{
@@ -154,6 +156,77 @@ namespace RTC
 			SSL_CTX_free(DtlsTransport::sslCtx);
 	}
 
+	/**
+	 * Called from a DtlsHandshakePool thread. The SSL object of the transport is
+	 * not touched by the loop until the job is done.
+	 */
+	void DtlsTransport::RunHandshakeJob(HandshakeJob* job)
+	{
+		MS_TRACE();
+
+		auto* transport = job->transport;
+
+		job->read = transport->ReadDtlsData(
+		  reinterpret_cast<const uint8_t*>(job->data.data()), job->data.size());
+
+		// Must be called in the thread that called SSL_read() since the OpenSSL
+		// error queue is per thread.
+		job->sslError = transport->GetSslError(job->read);
+
+		if (job->read > 0)
+			job->data.assign(reinterpret_cast<char*>(DtlsTransport::sslReadBuffer), job->read);
+		else
+			job->data.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(job->mutex);
+
+			job->done = true;
+		}
+
+		job->doneCond.notify_one();
+	}
+
+	void DtlsTransport::OnHandshakeJobDone(HandshakeJob* job)
+	{
+		MS_TRACE();
+
+		auto* transport = job->transport;
+
+		// The transport was closed or reset meanwhile.
+		if (!transport)
+		{
+			delete job;
+
+			return;
+		}
+
+		transport->handshakeJob = nullptr;
+
+		transport->OnDtlsDataRead(
+		  job->read, job->sslError, reinterpret_cast<const uint8_t*>(job->data.data()));
+
+		delete job;
+
+		// Process the DTLS data received meanwhile. It stops if a new job is
+		// submitted.
+		while (!transport->handshakeJob && !transport->pendingDtlsData.empty())
+		{
+			std::string data = std::move(transport->pendingDtlsData.front());
+
+			transport->pendingDtlsData.pop_front();
+
+			transport->ProcessDtlsData(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+		}
+
+		if (!transport->handshakeJob && transport->handshakeTimeoutPending)
+		{
+			transport->handshakeTimeoutPending = false;
+
+			transport->OnTimer(transport->timer);
+		}
+	}
+
 	void DtlsTransport::GenerateCertificateAndPrivateKey()
 	{
 		MS_TRACE();
@@ -645,6 +718,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		WaitForHandshakeJob();
+
 		if (IsRunning())
 		{
 			// Send close alert to the peer.
@@ -768,9 +843,6 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		int written;
-		int read;
-
 		if (!IsRunning())
 		{
 			MS_ERROR("cannot process data while not running");
@@ -778,47 +850,43 @@ namespace RTC
 			return;
 		}
 
-		// Write the received DTLS data into the sslBioFromNetwork.
-		written = BIO_write(this->sslBioFromNetwork, (const void*)data, static_cast<int>(len));
-
-		if (written != static_cast<int>(len))
+		// The SSL object is in use by the DtlsHandshakePool, so process the data
+		// once it is handed back.
+		if (this->handshakeJob)
 		{
-			MS_WARN_TAG(
-			  dtls,
-			  "OpenSSL BIO_write() wrote less (%zu bytes) than given data (%zu bytes)",
-			  static_cast<size_t>(written),
-			  len);
-		}
-
-		// Must call SSL_read() to process received DTLS data.
-		read = SSL_read(this->ssl, (void*)DtlsTransport::sslReadBuffer, SslReadBufferSize);
+			if (this->pendingDtlsData.size() >= MaxPendingDtlsData)
+			{
+				MS_WARN_TAG(
+				  dtls, "too many DTLS datagrams pending while processing handshake, discarding it");
 
-		// Send data if it's ready.
-		SendPendingOutgoingDtlsData();
+				return;
+			}
 
-		// Check SSL status and return if it is bad/closed.
-		if (!CheckStatus(read))
-			return;
+			this->pendingDtlsData.emplace_back(reinterpret_cast<const char*>(data), len);
 
-		// Set/update the DTLS timeout.
-		if (!SetTimeout())
 			return;
+		}
 
-		// Application data received. Notify to the listener.
-		if (read > 0)
+		// Key exchange and signatures during the handshake are expensive, so do
+		// not run them in the loop if there are threads for it.
+		if (!this->handshakeDone && DtlsHandshakePool::IsEnabled())
 		{
-			// It is allowed to receive DTLS data even before validating remote fingerprint.
-			if (!this->handshakeDone)
-			{
-				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
+			auto* job = new HandshakeJob();
 
-				return;
-			}
+			job->transport = this;
+			job->data.assign(reinterpret_cast<const char*>(data), len);
 
-			// Notify the listener.
-			this->listener->OnDtlsTransportApplicationDataReceived(
-			  this, (uint8_t*)DtlsTransport::sslReadBuffer, static_cast<size_t>(read));
+			this->handshakeJob = job;
+
+			DtlsHandshakePool::Submit(job);
+
+			return;
 		}
+
+		int read     = ReadDtlsData(data, len);
+		int sslError = GetSslError(read);
+
+		OnDtlsDataRead(read, sslError, DtlsTransport::sslReadBuffer);
 	}
 
 	void DtlsTransport::SendApplicationData(const uint8_t* data, size_t len)
@@ -848,7 +916,7 @@ namespace RTC
 		{
 			LOG_OPENSSL_ERROR("SSL_write() failed");
 
-			if (!CheckStatus(written))
+			if (!CheckStatus(GetSslError(written)))
 				return;
 		}
 		else if (written != static_cast<int>(len))
@@ -872,6 +940,13 @@ namespace RTC
 
 		MS_WARN_TAG(dtls, "resetting DTLS transport");
 
+		// Discard the handshake job in flight (if any) and the data received
+		// meanwhile.
+		WaitForHandshakeJob();
+
+		this->pendingDtlsData.clear();
+		this->handshakeTimeoutPending = false;
+
 		// Stop the DTLS timer.
 		this->timer->Stop();
 
@@ -895,12 +970,33 @@ namespace RTC
 			ERR_clear_error();
 	}
 
-	inline bool DtlsTransport::CheckStatus(int returnCode)
+	inline int DtlsTransport::ReadDtlsData(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		int written;
+
+		// Write the received DTLS data into the sslBioFromNetwork.
+		written = BIO_write(this->sslBioFromNetwork, (const void*)data, static_cast<int>(len));
+
+		if (written != static_cast<int>(len))
+		{
+			MS_WARN_TAG(
+			  dtls,
+			  "OpenSSL BIO_write() wrote less (%zu bytes) than given data (%zu bytes)",
+			  static_cast<size_t>(written),
+			  len);
+		}
+
+		// Must call SSL_read() to process received DTLS data.
+		return SSL_read(this->ssl, (void*)DtlsTransport::sslReadBuffer, SslReadBufferSize);
+	}
+
+	inline int DtlsTransport::GetSslError(int returnCode)
 	{
 		MS_TRACE();
 
 		int err;
-		bool wasHandshakeDone = this->handshakeDone;
 
 		err = SSL_get_error(this->ssl, returnCode);
 
@@ -943,6 +1039,48 @@ namespace RTC
 				MS_WARN_TAG(dtls, "SSL status: unknown error");
 		}
 
+		return err;
+	}
+
+	inline void DtlsTransport::OnDtlsDataRead(int read, int sslError, const uint8_t* readData)
+	{
+		MS_TRACE();
+
+		// Send data if it's ready.
+		SendPendingOutgoingDtlsData();
+
+		// Check SSL status and return if it is bad/closed.
+		if (!CheckStatus(sslError))
+			return;
+
+		// Set/update the DTLS timeout.
+		if (!SetTimeout())
+			return;
+
+		// Application data received. Notify to the listener.
+		if (read > 0)
+		{
+			// It is allowed to receive DTLS data even before validating remote fingerprint.
+			if (!this->handshakeDone)
+			{
+				MS_WARN_TAG(dtls, "ignoring application data received while DTLS handshake not done");
+
+				return;
+			}
+
+			// Notify the listener.
+			this->listener->OnDtlsTransportApplicationDataReceived(
+			  this, readData, static_cast<size_t>(read));
+		}
+	}
+
+	inline bool DtlsTransport::CheckStatus(int sslError)
+	{
+		MS_TRACE();
+
+		int err               = sslError;
+		bool wasHandshakeDone = this->handshakeDone;
+
 		// Check if the handshake (or re-handshake) has been done right now.
 		if (this->handshakeDoneNow)
 		{
@@ -990,6 +1128,30 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Blocks until the handshake job in flight (if any) has been processed, and
+	 * discards it. It is deleted once handed back by the DtlsHandshakePool.
+	 */
+	void DtlsTransport::WaitForHandshakeJob()
+	{
+		MS_TRACE();
+
+		auto* job = this->handshakeJob;
+
+		if (!job)
+			return;
+
+		// Sleep rather than spin, a key exchange may take a while.
+		{
+			std::unique_lock<std::mutex> lock(job->mutex);
+
+			job->doneCond.wait(lock, [job]() { return job->done; });
+		}
+
+		job->transport     = nullptr;
+		this->handshakeJob = nullptr;
+	}
+
 	inline void DtlsTransport::SendPendingOutgoingDtlsData()
 	{
 		MS_TRACE();
@@ -1452,6 +1614,15 @@ namespace RTC
 			return;
 		}
 
+		// The SSL object is in use by the DtlsHandshakePool, so handle the timeout
+		// once it is handed back.
+		if (this->handshakeJob)
+		{
+			this->handshakeTimeoutPending = true;
+
+			return;
+		}
+
 		DTLSv1_handle_timeout(this->ssl);
 
 		// If required, send DTLS data.
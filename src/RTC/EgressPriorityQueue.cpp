@@ -0,0 +1,479 @@
+#define MS_CLASS "RTC::EgressPriorityQueue"
+// #define MS_LOG_DEV
+
+#include "RTC/EgressPriorityQueue.hpp"
+#include "BufferPool.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include <cstring> // std::memcpy()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Max bytes kept in the queue of a transport.
+	static constexpr size_t MaxQueuedBytes{ 524288 };
+	// Max bytes sent by a transport per loop iteration, so the socket is checked
+	// again before sending the rest.
+	static constexpr size_t DrainQuantum{ 65536 };
+	static constexpr size_t NumPriorities{ 4 };
+	static const char* PriorityNames[NumPriorities] = { "audio", "video", "rtx", "probation" };
+	// Timer wheel with 1 ms slots (the libuv timer resolution). Queues waiting
+	// longer than the wheel size are placed in the last slot and checked again.
+	static constexpr uint64_t WheelTickInterval{ 1 };
+	static constexpr size_t WheelSlots{ 64 };
+	static thread_local std::vector<EgressPriorityQueue*> Wheel[WheelSlots];
+
+	/* Static methods for UV callbacks. */
+
+	inline static void onIdle(uv_idle_t* /*handle*/)
+	{
+		// Do nothing. DrainAll() is called once the loop iteration goes on.
+	}
+
+	inline static void onClose(uv_handle_t* handle)
+	{
+		delete handle;
+	}
+
+	/* Class variables. */
+
+	thread_local std::vector<EgressPriorityQueue*> EgressPriorityQueue::pendingQueues;
+	thread_local std::vector<EgressPriorityQueue*> EgressPriorityQueue::drainingQueues;
+	thread_local EgressPriorityQueue::Ticker* EgressPriorityQueue::ticker{ nullptr };
+	thread_local uv_idle_t* EgressPriorityQueue::idleHandle{ nullptr };
+	thread_local uint64_t EgressPriorityQueue::wheelTime{ 0 };
+	thread_local size_t EgressPriorityQueue::numScheduledQueues{ 0 };
+
+	/* Class methods. */
+
+	void EgressPriorityQueue::ClassInit()
+	{
+		MS_TRACE();
+
+		EgressPriorityQueue::ticker = new EgressPriorityQueue::Ticker();
+
+		EgressPriorityQueue::idleHandle = new uv_idle_t;
+
+		int err = uv_idle_init(DepLibUV::GetLoop(), EgressPriorityQueue::idleHandle);
+
+		if (err != 0)
+		{
+			delete EgressPriorityQueue::idleHandle;
+			EgressPriorityQueue::idleHandle = nullptr;
+
+			MS_THROW_ERROR("uv_idle_init() failed: %s", uv_strerror(err));
+		}
+
+		// It must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(EgressPriorityQueue::idleHandle));
+
+		DepLibUV::AddFlushCallback(EgressPriorityQueue::DrainAll);
+	}
+
+	void EgressPriorityQueue::ClassDestroy()
+	{
+		MS_TRACE();
+
+		delete EgressPriorityQueue::ticker;
+		EgressPriorityQueue::ticker = nullptr;
+
+		if (EgressPriorityQueue::idleHandle)
+		{
+			uv_close(
+			  reinterpret_cast<uv_handle_t*>(EgressPriorityQueue::idleHandle),
+			  static_cast<uv_close_cb>(onClose));
+			EgressPriorityQueue::idleHandle = nullptr;
+		}
+	}
+
+	void EgressPriorityQueue::DrainAll()
+	{
+		// Started again below by queues that reach the quantum.
+		uv_idle_stop(EgressPriorityQueue::idleHandle);
+
+		if (EgressPriorityQueue::pendingQueues.empty())
+			return;
+
+		// Queues becoming pending again while draining go to the (now empty)
+		// pendingQueues, so they are drained in the next loop iteration. Deleted
+		// queues are replaced with null.
+		auto& drainingQueues = EgressPriorityQueue::drainingQueues;
+
+		drainingQueues.swap(EgressPriorityQueue::pendingQueues);
+
+		for (auto*& egressQueue : drainingQueues)
+		{
+			if (!egressQueue)
+				continue;
+
+			egressQueue->listed = false;
+
+			if (egressQueue->pending)
+			{
+				egressQueue->pending = false;
+				egressQueue->Drain();
+			}
+		}
+
+		drainingQueues.clear();
+	}
+
+	void EgressPriorityQueue::Schedule(EgressPriorityQueue* egressQueue, uint64_t delay)
+	{
+		MS_TRACE();
+
+		EgressPriorityQueue::Unschedule(egressQueue);
+
+		++EgressPriorityQueue::numScheduledQueues;
+
+		// NOTE: The ticker may be running with no scheduled queue if called while
+		// processing the wheel.
+		if (!EgressPriorityQueue::ticker->IsActive())
+		{
+			EgressPriorityQueue::wheelTime = DepLibUV::GetTime();
+
+			EgressPriorityQueue::ticker->Start();
+		}
+
+		delay = std::max(delay, uint64_t{ 1 });
+		delay = std::min(delay, uint64_t{ WheelSlots - 1 });
+
+		auto slot = static_cast<int32_t>((EgressPriorityQueue::wheelTime + delay) % WheelSlots);
+
+		egressQueue->wheelSlot    = slot;
+		egressQueue->wheelSlotIdx = Wheel[slot].size();
+		Wheel[slot].push_back(egressQueue);
+	}
+
+	void EgressPriorityQueue::Unschedule(EgressPriorityQueue* egressQueue)
+	{
+		MS_TRACE();
+
+		if (egressQueue->wheelSlot == -1)
+			return;
+
+		auto& slot = Wheel[egressQueue->wheelSlot];
+
+		// Move the last queue of the slot into the position of this one.
+		auto* lastQueue = slot.back();
+
+		slot[egressQueue->wheelSlotIdx] = lastQueue;
+		lastQueue->wheelSlotIdx         = egressQueue->wheelSlotIdx;
+		slot.pop_back();
+
+		egressQueue->wheelSlot = -1;
+
+		if (--EgressPriorityQueue::numScheduledQueues == 0)
+			EgressPriorityQueue::ticker->Stop();
+	}
+
+	void EgressPriorityQueue::OnWheelTick()
+	{
+		MS_TRACE();
+
+		uint64_t now   = DepLibUV::GetTime();
+		uint64_t steps = std::min(now - EgressPriorityQueue::wheelTime, uint64_t{ WheelSlots });
+
+		for (uint64_t i{ 1 }; i <= steps && EgressPriorityQueue::numScheduledQueues != 0; ++i)
+		{
+			// Queues scheduled again while draining must go to next slots.
+			++EgressPriorityQueue::wheelTime;
+
+			std::vector<EgressPriorityQueue*> dueQueues;
+
+			dueQueues.swap(Wheel[EgressPriorityQueue::wheelTime % WheelSlots]);
+
+			for (auto* egressQueue : dueQueues)
+			{
+				egressQueue->wheelSlot = -1;
+				--EgressPriorityQueue::numScheduledQueues;
+			}
+
+			for (auto* egressQueue : dueQueues)
+			{
+				egressQueue->Drain();
+			}
+		}
+
+		EgressPriorityQueue::wheelTime = now;
+
+		if (EgressPriorityQueue::numScheduledQueues == 0)
+			EgressPriorityQueue::ticker->Stop();
+	}
+
+	/* Instance methods. */
+
+	EgressPriorityQueue::EgressPriorityQueue(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+	}
+
+	EgressPriorityQueue::~EgressPriorityQueue()
+	{
+		MS_TRACE();
+
+		Clear();
+
+		if (this->listed)
+		{
+			auto& pendingQueues  = EgressPriorityQueue::pendingQueues;
+			auto& drainingQueues = EgressPriorityQueue::drainingQueues;
+			auto it              = std::find(pendingQueues.begin(), pendingQueues.end(), this);
+
+			if (it != pendingQueues.end())
+				pendingQueues.erase(it);
+			else
+				*std::find(drainingQueues.begin(), drainingQueues.end(), this) = nullptr;
+		}
+	}
+
+	void EgressPriorityQueue::FillJsonStats(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		size_t packets{ 0 };
+
+		jsonObject["egressQueueDrops"] = json::object();
+		auto jsonDropsIt               = jsonObject.find("egressQueueDrops");
+
+		for (size_t i{ 0 }; i < NumPriorities; ++i)
+		{
+			packets += this->queues[i].packets.size();
+
+			(*jsonDropsIt)[PriorityNames[i]] = this->queues[i].drops;
+		}
+
+		jsonObject["egressQueuePackets"] = packets;
+		jsonObject["egressQueueBytes"]   = this->bytes;
+		jsonObject["pacingBitrate"]      = this->pacingBitrate;
+	}
+
+	void EgressPriorityQueue::SetPacingBitrate(uint32_t bitrate)
+	{
+		MS_TRACE();
+
+		// Account the budget earned with the previous bitrate. If not paced so far
+		// start with a full burst.
+		RefillPacingBudget();
+
+		if (this->pacingBitrate == 0)
+			this->pacingBudget = Settings::configuration.pacerBurstBytes;
+
+		this->pacingBitrate = bitrate;
+	}
+
+	bool EgressPriorityQueue::UsePacingBudget(size_t len)
+	{
+		MS_TRACE();
+
+		if (this->pacingBitrate == 0 || Settings::configuration.pacerBurstBytes == 0)
+			return true;
+
+		RefillPacingBudget();
+
+		if (this->pacingBudget <= 0)
+			return false;
+
+		this->pacingBudget -= static_cast<int64_t>(len);
+
+		return true;
+	}
+
+	void EgressPriorityQueue::Push(Priority priority, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		auto idx = static_cast<size_t>(priority);
+
+		// Make room by dropping the oldest packets of lower priority queues.
+		for (size_t lowerIdx{ NumPriorities - 1 }; lowerIdx > idx && this->bytes + len > MaxQueuedBytes;
+		     --lowerIdx)
+		{
+			auto& lowerQueue = this->queues[lowerIdx];
+
+			while (!lowerQueue.packets.empty() && this->bytes + len > MaxQueuedBytes)
+			{
+				auto& droppedPacket = lowerQueue.packets.front();
+				size_t droppedLen   = droppedPacket.len;
+
+				BufferPool::Free(droppedPacket.data);
+				lowerQueue.packets.pop_front();
+				lowerQueue.bytes -= droppedLen;
+				this->bytes -= droppedLen;
+				++lowerQueue.drops;
+			}
+		}
+
+		auto& queue = this->queues[idx];
+
+		if (this->bytes + len > MaxQueuedBytes)
+		{
+			MS_DEBUG_DEV("egress queue full, dropping %s packet", PriorityNames[idx]);
+
+			++queue.drops;
+
+			return;
+		}
+
+		Packet packet{ BufferPool::Allocate(len), len };
+
+		std::memcpy(packet.data, data, len);
+
+		queue.packets.push_back(packet);
+		queue.bytes += len;
+		this->bytes += len;
+
+		// If waiting for pacing budget the timer wheel will drain it.
+		if (this->wheelSlot == -1)
+			SetPending(true);
+	}
+
+	void EgressPriorityQueue::Clear()
+	{
+		MS_TRACE();
+
+		for (auto& queue : this->queues)
+		{
+			for (auto& packet : queue.packets)
+			{
+				BufferPool::Free(packet.data);
+			}
+
+			queue.packets.clear();
+			queue.bytes = 0;
+		}
+
+		this->bytes = 0;
+
+		SetPending(false);
+		EgressPriorityQueue::Unschedule(this);
+	}
+
+	void EgressPriorityQueue::Drain()
+	{
+		MS_TRACE();
+
+		size_t drainedBytes{ 0 };
+
+		for (auto& queue : this->queues)
+		{
+			while (!queue.packets.empty() && drainedBytes < DrainQuantum)
+			{
+				if (!this->listener->OnEgressPriorityQueueCanSend(this))
+				{
+					SetPending(true);
+
+					return;
+				}
+
+				if (!UsePacingBudget(queue.packets.front().len))
+				{
+					// Wait until the budget is positive again.
+					auto delay =
+					  static_cast<uint64_t>((1 - this->pacingBudget) * 8000 / this->pacingBitrate) + 1;
+
+					SetPending(false);
+					EgressPriorityQueue::Schedule(this, delay);
+
+					return;
+				}
+
+				// Take it out so the listener may push into the queue while sending.
+				auto packet = queue.packets.front();
+
+				queue.packets.pop_front();
+				queue.bytes -= packet.len;
+				this->bytes -= packet.len;
+				drainedBytes += packet.len;
+
+				this->listener->OnEgressPriorityQueueSend(this, packet.data, packet.len);
+
+				BufferPool::Free(packet.data);
+			}
+		}
+
+		SetPending(this->bytes != 0);
+
+		// The quantum was reached, so drain the rest without waiting for I/O.
+		if (this->bytes != 0)
+			uv_idle_start(EgressPriorityQueue::idleHandle, static_cast<uv_idle_cb>(onIdle));
+	}
+
+	void EgressPriorityQueue::SetPending(bool pending)
+	{
+		MS_TRACE();
+
+		if (pending == this->pending)
+			return;
+
+		this->pending = pending;
+
+		// NOTE: Not pending queues are removed from the list in DrainAll().
+		if (pending && !this->listed)
+		{
+			this->listed = true;
+
+			EgressPriorityQueue::pendingQueues.push_back(this);
+		}
+	}
+
+	void EgressPriorityQueue::RefillPacingBudget()
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		this->pacingBudget +=
+		  static_cast<int64_t>((now - this->pacingBudgetUpdatedAt) * this->pacingBitrate / 8000);
+		this->pacingBudget =
+		  std::min(this->pacingBudget, static_cast<int64_t>(Settings::configuration.pacerBurstBytes));
+		this->pacingBudgetUpdatedAt = now;
+	}
+
+	/* EgressPriorityQueue::Ticker instance methods. */
+
+	EgressPriorityQueue::Ticker::Ticker()
+	{
+		MS_TRACE();
+
+		this->timer = new Timer(this);
+	}
+
+	EgressPriorityQueue::Ticker::~Ticker()
+	{
+		MS_TRACE();
+
+		delete this->timer;
+	}
+
+	void EgressPriorityQueue::Ticker::Start()
+	{
+		MS_TRACE();
+
+		this->timer->Start(WheelTickInterval, WheelTickInterval);
+	}
+
+	void EgressPriorityQueue::Ticker::Stop()
+	{
+		MS_TRACE();
+
+		this->timer->Stop();
+	}
+
+	bool EgressPriorityQueue::Ticker::IsActive() const
+	{
+		MS_TRACE();
+
+		return this->timer->IsActive();
+	}
+
+	void EgressPriorityQueue::Ticker::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		EgressPriorityQueue::OnWheelTick();
+	}
+} // namespace RTC
@@ -11,7 +11,7 @@ namespace RTC
 	/* Static. */
 
 	static constexpr size_t StunSerializeBufferSize{ 65536 };
-	static uint8_t StunSerializeBuffer[StunSerializeBufferSize];
+	static thread_local uint8_t StunSerializeBuffer[StunSerializeBufferSize];
 
 	/* Instance methods. */
 
@@ -475,6 +475,9 @@ namespace RTC
 		if (storedTuple->GetProtocol() == TransportTuple::Protocol::UDP)
 			storedTuple->StoreUdpRemoteAddress();
 
+		// Notify the listener.
+		this->listener->OnIceServerTupleAdded(this, storedTuple);
+
 		// Return the address of the inserted tuple.
 		return storedTuple;
 	}
@@ -156,6 +156,9 @@ namespace RTC
 			return;
 		}
 
+		// Undo the payload rewrite left by a previous Consumer of the same packet.
+		packet->RestorePayload();
+
 		auto* rtpStream     = this->mapMappedSsrcRtpStream.at(packet->GetSsrc());
 		auto& syncRequired  = this->mapRtpStreamSyncRequired.at(rtpStream);
 		auto& rtpSeqManager = this->mapRtpStreamRtpSeqManager.at(rtpStream);
@@ -184,12 +187,10 @@ namespace RTC
 
 		rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
-		// Save original packet fields.
-		auto origSeq = packet->GetSequenceNumber();
-
-		// Rewrite packet.
+		// Build the packet to send with the rewritten header. The original packet,
+		// which may be shared with other Consumers, is not modified.
 		// NOTE: Do not override the ssrc because we want to honor the consumable ssrcs.
-		packet->SetSequenceNumber(seq);
+		RTC::EgressRtpPacket egressPacket(packet, packet->GetSsrc(), seq, packet->GetTimestamp());
 
 		if (isSyncPacket)
 		{
@@ -197,17 +198,17 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq);
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
+			  packet->GetSequenceNumber());
 		}
 
 		// Process the packet.
-		if (rtpStream->ReceivePacket(packet))
+		if (rtpStream->ReceivePacket(egressPacket))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, egressPacket);
 		}
 		else
 		{
@@ -215,14 +216,11 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq);
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
+			  packet->GetSequenceNumber());
 		}
-
-		// Restore packet fields.
-		packet->SetSequenceNumber(origSeq);
 	}
 
 	void PipeConsumer::SendProbationRtpPacket(uint16_t /*seq*/)
@@ -6,9 +6,14 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include <cstring> // std::memcpy()
 
 namespace RTC
 {
+	/* Class variables. */
+
+	thread_local std::unordered_map<std::string, PipeTransport*> PipeTransport::mapIdPipeTransport;
+
 	/* Instance methods. */
 
 	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -46,11 +51,26 @@ namespace RTC
 			this->listenIp.announcedIp.assign(jsonAnnouncedIpIt->get<std::string>());
 		}
 
+		bool enableSharedMemory{ false };
+		auto jsonEnableSharedMemoryIt = data.find("enableSharedMemory");
+
+		if (jsonEnableSharedMemoryIt != data.end())
+		{
+			if (!jsonEnableSharedMemoryIt->is_boolean())
+				MS_THROW_TYPE_ERROR("wrong enableSharedMemory (not a boolean)");
+
+			enableSharedMemory = jsonEnableSharedMemoryIt->get<bool>();
+		}
+
 		try
 		{
 			// This may throw.
 			this->udpSocket = new RTC::UdpSocket(this, this->listenIp.ip);
 
+			// This may throw.
+			if (enableSharedMemory)
+				this->sharedMemoryPipe = new RTC::SharedMemoryPipe(this, this->id);
+
 			// May create SCTP association.
 			CreateSctpAssociation(data);
 		}
@@ -60,11 +80,16 @@ namespace RTC
 
 			DestroySctpAssociation();
 
+			delete this->sharedMemoryPipe;
+			this->sharedMemoryPipe = nullptr;
+
 			delete this->udpSocket;
 			this->udpSocket = nullptr;
 
 			throw;
 		}
+
+		PipeTransport::mapIdPipeTransport.emplace(this->id, this);
 	}
 
 	PipeTransport::~PipeTransport()
@@ -74,6 +99,32 @@ namespace RTC
 		// Must delete the SCTP association first since it will generate SCTP packets.
 		DestroySctpAssociation();
 
+		auto it = PipeTransport::mapIdPipeTransport.find(this->id);
+
+		if (it != PipeTransport::mapIdPipeTransport.end() && it->second == this)
+			PipeTransport::mapIdPipeTransport.erase(it);
+
+		// PipeTransports piped to this one get disconnected.
+		for (auto& kv : PipeTransport::mapIdPipeTransport)
+		{
+			auto* pipeTransport = kv.second;
+
+			if (pipeTransport->pipedTransport != this)
+				continue;
+
+			pipeTransport->pipedTransport = nullptr;
+			pipeTransport->Disconnected();
+		}
+
+		delete this->sharedMemoryPipe;
+
+		if (this->sharedMemoryConnectRequest != nullptr)
+		{
+			this->sharedMemoryConnectRequest->Error("PipeTransport closed");
+
+			delete this->sharedMemoryConnectRequest;
+		}
+
 		delete this->udpSocket;
 
 		delete this->tuple;
@@ -86,6 +137,14 @@ namespace RTC
 		// Call the parent method.
 		RTC::Transport::FillJson(jsonObject);
 
+		// Add pipeTransportId.
+		if (this->pipedTransport != nullptr)
+			jsonObject["pipeTransportId"] = this->pipedTransport->id;
+
+		// Add sharedMemoryName.
+		if (this->sharedMemoryPipe != nullptr)
+			jsonObject["sharedMemoryName"] = this->sharedMemoryPipe->GetName();
+
 		// Add tuple.
 		if (this->tuple != nullptr)
 		{
@@ -186,8 +245,67 @@ namespace RTC
 			case Channel::Request::MethodId::TRANSPORT_CONNECT:
 			{
 				// Ensure this method is not called twice.
-				if (this->tuple != nullptr)
+				// clang-format off
+				if (
+					this->tuple != nullptr ||
+					this->pipedTransport != nullptr ||
+					this->sharedMemoryConnecting
+				)
+				// clang-format on
+				{
 					MS_THROW_ERROR("connect() already called");
+				}
+
+				auto jsonSharedMemoryNameIt = request->data.find("sharedMemoryName");
+
+				// Pipe with the shared memory of another PipeTransport in this host.
+				if (jsonSharedMemoryNameIt != request->data.end())
+				{
+					if (!this->sharedMemoryPipe)
+						MS_THROW_TYPE_ERROR("shared memory not enabled");
+					else if (!jsonSharedMemoryNameIt->is_string())
+						MS_THROW_TYPE_ERROR("wrong sharedMemoryName (not a string)");
+
+					// This may throw.
+					this->sharedMemoryPipe->Connect(jsonSharedMemoryNameIt->get<std::string>());
+
+					this->sharedMemoryConnecting = true;
+
+					// The request is replied (and the parent class told) once the remote
+					// ring is mapped, so the remote PipeTransport must be connected too.
+					this->sharedMemoryConnectRequest = new Channel::Request(*request);
+
+					break;
+				}
+
+				auto jsonPipeTransportIdIt = request->data.find("pipeTransportId");
+
+				// Pipe with another PipeTransport in this thread (no UDP involved).
+				if (jsonPipeTransportIdIt != request->data.end())
+				{
+					if (!jsonPipeTransportIdIt->is_string())
+						MS_THROW_TYPE_ERROR("wrong pipeTransportId (not a string)");
+
+					auto it = PipeTransport::mapIdPipeTransport.find(jsonPipeTransportIdIt->get<std::string>());
+
+					if (it == PipeTransport::mapIdPipeTransport.end())
+						MS_THROW_ERROR("PipeTransport not found in the same thread");
+					else if (it->second == this)
+						MS_THROW_TYPE_ERROR("cannot pipe a PipeTransport with itself");
+
+					this->pipedTransport = it->second;
+
+					json data = json::object();
+
+					data["pipeTransportId"] = this->pipedTransport->id;
+
+					request->Accept(data);
+
+					// Tell the parent class.
+					RTC::Transport::Connected();
+
+					break;
+				}
 
 				try
 				{
@@ -289,24 +407,36 @@ namespace RTC
 
 	inline bool PipeTransport::IsConnected() const
 	{
-		return this->tuple != nullptr;
+		// clang-format off
+		return (
+			this->tuple != nullptr ||
+			this->pipedTransport != nullptr ||
+			(this->sharedMemoryPipe != nullptr && this->sharedMemoryPipe->IsConnected())
+		);
+		// clang-format on
 	}
 
 	void PipeTransport::SendRtpPacket(
-	  RTC::RtpPacket* packet, RTC::Consumer* /*consumer*/, bool /*retransmitted*/, bool /*probation*/)
+	  const RTC::EgressRtpPacket& egressPacket,
+	  RTC::Consumer* /*consumer*/,
+	  bool /*retransmitted*/,
+	  bool /*probation*/)
 	{
 		MS_TRACE();
 
 		if (!IsConnected())
 			return;
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
-
-		this->tuple->Send(data, len);
+		// Send the consumer header and the rest of the packet without
+		// assembling them.
+		SendData(
+		  egressPacket.GetHeader(),
+		  RTC::EgressRtpPacket::HeaderSize,
+		  egressPacket.GetBody(),
+		  egressPacket.GetBodySize());
 
 		// Increase send transmission.
-		RTC::Transport::DataSent(len);
+		RTC::Transport::DataSent(egressPacket.GetSize());
 	}
 
 	void PipeTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
@@ -319,7 +449,7 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
-		this->tuple->Send(data, len);
+		SendData(data, len);
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -335,7 +465,7 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
-		this->tuple->Send(data, len);
+		SendData(data, len);
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -376,8 +506,9 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
-		// Verify that the packet's tuple matches our tuple.
-		if (!this->tuple->Compare(tuple))
+		// Verify that the packet's tuple matches our tuple (there is no tuple if
+		// it was given by the piped PipeTransport or read from shared memory).
+		if (tuple != nullptr && !this->tuple->Compare(tuple))
 		{
 			MS_DEBUG_TAG(rtp, "ignoring RTP packet from unknown IP:port");
 
@@ -429,8 +560,9 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
-		// Verify that the packet's tuple matches our tuple.
-		if (!this->tuple->Compare(tuple))
+		// Verify that the packet's tuple matches our tuple (there is no tuple if
+		// it was given by the piped PipeTransport or read from shared memory).
+		if (tuple != nullptr && !this->tuple->Compare(tuple))
 		{
 			MS_DEBUG_TAG(rtcp, "ignoring RTCP packet from unknown IP:port");
 
@@ -473,8 +605,9 @@ namespace RTC
 			return;
 		}
 
-		// Verify that the packet's tuple matches our tuple.
-		if (!this->tuple->Compare(tuple))
+		// Verify that the packet's tuple matches our tuple (there is no tuple if
+		// it was given by the piped PipeTransport or read from shared memory).
+		if (tuple != nullptr && !this->tuple->Compare(tuple))
 		{
 			MS_DEBUG_TAG(sctp, "ignoring SCTP packet from unknown IP:port");
 
@@ -485,6 +618,48 @@ namespace RTC
 		this->sctpAssociation->ProcessSctpData(data, len);
 	}
 
+	inline void PipeTransport::SendData(
+	  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2)
+	{
+		MS_TRACE();
+
+		if (this->pipedTransport != nullptr)
+			this->pipedTransport->ReceivePipedData(this, data1, len1, data2, len2);
+		else if (this->tuple != nullptr)
+			this->tuple->Send(data1, len1, data2, len2);
+		else
+			this->sharedMemoryPipe->Send(data1, len1, data2, len2);
+	}
+
+	void PipeTransport::ReceivePipedData(
+	  PipeTransport* pipeTransport, const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2)
+	{
+		MS_TRACE();
+
+		// Just accept data from the PipeTransport this one is piped with.
+		if (pipeTransport != this->pipedTransport)
+		{
+			MS_DEBUG_DEV("ignoring data from a non piped PipeTransport");
+
+			return;
+		}
+
+		// Packets are modified while being processed (the Producer mangles them)
+		// and the given data still belongs to the sender so copy them. This is not
+		// static since piped Routers may be chained and hence this is reentrant.
+		uint8_t buffer[RTC::RtpBufferSize];
+		size_t len = len1 + len2;
+
+		MS_ASSERT(len <= sizeof(buffer), "piped data too big");
+
+		std::memcpy(buffer, data1, len1);
+
+		if (len2 != 0)
+			std::memcpy(buffer + len1, data2, len2);
+
+		OnPacketReceived(nullptr, buffer, len);
+	}
+
 	void PipeTransport::UserOnNewProducer(RTC::Producer* /*producer*/)
 	{
 		MS_TRACE();
@@ -511,7 +686,7 @@ namespace RTC
 		if (!IsConnected())
 			return;
 
-		this->tuple->Send(data, len);
+		SendData(data, len);
 
 		// Increase send transmission.
 		RTC::Transport::DataSent(len);
@@ -533,4 +708,50 @@ namespace RTC
 
 		OnPacketReceived(&tuple, data, len);
 	}
+
+	inline void PipeTransport::OnSharedMemoryPipeConnected(RTC::SharedMemoryPipe* /*pipe*/)
+	{
+		MS_TRACE();
+
+		if (this->sharedMemoryConnectRequest != nullptr)
+		{
+			this->sharedMemoryConnectRequest->Accept();
+
+			delete this->sharedMemoryConnectRequest;
+			this->sharedMemoryConnectRequest = nullptr;
+		}
+
+		// Tell the parent class.
+		RTC::Transport::Connected();
+	}
+
+	inline void PipeTransport::OnSharedMemoryPipeFailed(RTC::SharedMemoryPipe* /*pipe*/)
+	{
+		MS_TRACE();
+
+		// Let connect() be called again.
+		this->sharedMemoryConnecting = false;
+
+		if (this->sharedMemoryConnectRequest != nullptr)
+		{
+			this->sharedMemoryConnectRequest->Error("could not connect to the remote shared memory pipe");
+
+			delete this->sharedMemoryConnectRequest;
+			this->sharedMemoryConnectRequest = nullptr;
+		}
+		// The pipe was connected and has been closed.
+		else
+		{
+			// Tell the parent class.
+			RTC::Transport::Disconnected();
+		}
+	}
+
+	inline void PipeTransport::OnSharedMemoryPipePacketReceived(
+	  RTC::SharedMemoryPipe* /*pipe*/, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		OnPacketReceived(nullptr, data, len);
+	}
 } // namespace RTC
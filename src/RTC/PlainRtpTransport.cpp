@@ -480,20 +480,26 @@ namespace RTC
 	}
 
 	void PlainRtpTransport::SendRtpPacket(
-	  RTC::RtpPacket* packet, RTC::Consumer* /*consumer*/, bool /*retransmitted*/, bool /*probation*/)
+	  const RTC::EgressRtpPacket& egressPacket,
+	  RTC::Consumer* /*consumer*/,
+	  bool /*retransmitted*/,
+	  bool /*probation*/)
 	{
 		MS_TRACE();
 
 		if (!IsConnected())
 			return;
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
-
-		this->tuple->Send(data, len);
+		// Send the consumer header and the rest of the packet without
+		// assembling them.
+		this->tuple->Send(
+		  egressPacket.GetHeader(),
+		  RTC::EgressRtpPacket::HeaderSize,
+		  egressPacket.GetBody(),
+		  egressPacket.GetBodySize());
 
 		// Increase send transmission.
-		RTC::Transport::DataSent(len);
+		RTC::Transport::DataSent(egressPacket.GetSize());
 	}
 
 	void PlainRtpTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
@@ -32,6 +32,7 @@ namespace RTC
 
 	std::unordered_map<std::string, std::vector<bool>> PortManager::mapUdpIpPorts;
 	std::unordered_map<std::string, std::vector<bool>> PortManager::mapTcpIpPorts;
+	std::mutex PortManager::mutex;
 
 	/* Class methods. */
 
@@ -42,6 +43,8 @@ namespace RTC
 		// First normalize the IP. This may throw if invalid IP.
 		Utils::IP::NormalizeIp(ip);
 
+		std::lock_guard<std::mutex> lock(PortManager::mutex);
+
 		int err;
 		int family = Utils::IP::GetFamily(ip);
 		struct sockaddr_storage bindAddr; // NOLINT(cppcoreguidelines-pro-type-member-init)
@@ -313,6 +316,8 @@ namespace RTC
 
 		size_t portIdx = static_cast<size_t>(port) - Settings::configuration.rtcMinPort;
 
+		std::lock_guard<std::mutex> lock(PortManager::mutex);
+
 		switch (transport)
 		{
 			case Transport::UDP:
@@ -407,6 +412,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		std::lock_guard<std::mutex> lock(PortManager::mutex);
+
 		// Add udp.
 		jsonObject["udp"] = json::object();
 		auto jsonUdpIt    = jsonObject.find("udp");
@@ -16,7 +16,7 @@ namespace RTC
 	{
 		/* Namespace variables. */
 
-		uint8_t Buffer[BufferSize];
+		thread_local uint8_t Buffer[BufferSize];
 
 		/* Class variables. */
 
@@ -157,6 +157,13 @@ namespace RTC
 
 			(*jsonMapDataConsumerDataProducerIt)[dataConsumer->id] = dataProducer->id;
 		}
+
+		// Add payloadRewrites.
+		jsonObject["payloadRewrites"] = json::object();
+		auto jsonPayloadRewritesIt    = jsonObject.find("payloadRewrites");
+
+		(*jsonPayloadRewritesIt)["consumers"] = this->numPayloadProcessed;
+		(*jsonPayloadRewritesIt)["rewrites"]  = this->numPayloadRewrites;
 	}
 
 	void Router::HandleRequest(Channel::Request* request)
@@ -636,6 +643,17 @@ namespace RTC
 			consumer->SendRtpPacket(packet);
 		}
 
+		// Consumers leave their payload rewrite in the packet so the next ones with
+		// the same encoding context state do not need to rewrite it again. Account
+		// it and restore the original payload.
+		if (packet->GetNumPayloadProcessed() != 0)
+		{
+			this->numPayloadProcessed += packet->GetNumPayloadProcessed();
+			this->numPayloadRewrites += packet->GetNumPayloadRewrites();
+
+			packet->RestorePayload();
+		}
+
 		auto it = this->mapProducerRtpObservers.find(producer);
 
 		if (it != this->mapProducerRtpObservers.end())
@@ -3,12 +3,20 @@
 
 #include "RTC/RtpPacket.hpp"
 #include "Logger.hpp"
-#include <cstring>  // std::memcpy(), std::memmove()
+#include "RTC/SharedRtpPacket.hpp"
+#include <cstring>  // std::memcpy(), std::memmove(), std::memset()
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
 
 namespace RTC
 {
+	/* Static. */
+
+	static constexpr size_t MaxPooledRtpPackets{ 1024 };
+	// Memory of deleted RtpPacket instances, reused by later ones.
+	static thread_local void* RtpPacketPool[MaxPooledRtpPackets];
+	static thread_local size_t NumPooledRtpPackets{ 0 };
+
 	/* Class methods. */
 
 	RtpPacket* RtpPacket::Parse(const uint8_t* data, size_t len)
@@ -123,6 +131,39 @@ namespace RTC
 		return packet;
 	}
 
+	void RtpPacket::ClassDestroy()
+	{
+		MS_TRACE();
+
+		while (NumPooledRtpPackets != 0)
+		{
+			::operator delete(RtpPacketPool[--NumPooledRtpPackets]);
+		}
+	}
+
+	void* RtpPacket::operator new(size_t size)
+	{
+		if (size != sizeof(RtpPacket) || NumPooledRtpPackets == 0)
+			return ::operator new(size);
+
+		return RtpPacketPool[--NumPooledRtpPackets];
+	}
+
+	void RtpPacket::operator delete(void* ptr, size_t size)
+	{
+		if (!ptr)
+			return;
+
+		if (size != sizeof(RtpPacket) || NumPooledRtpPackets == MaxPooledRtpPackets)
+		{
+			::operator delete(ptr);
+
+			return;
+		}
+
+		RtpPacketPool[NumPooledRtpPackets++] = ptr;
+	}
+
 	/* Instance methods. */
 
 	RtpPacket::RtpPacket(
@@ -147,6 +188,9 @@ namespace RTC
 	RtpPacket::~RtpPacket()
 	{
 		MS_TRACE();
+
+		if (this->sharedPacket)
+			this->sharedPacket->Release();
 	}
 
 	void RtpPacket::Dump() const
@@ -177,20 +221,18 @@ namespace RTC
 
 			if (HasOneByteExtensions())
 			{
-				extIds.reserve(this->mapOneByteExtensions.size());
-
-				for (auto& kv : this->mapOneByteExtensions)
+				for (size_t id{ 1 }; id < 15; ++id)
 				{
-					extIds.push_back(std::to_string(kv.first));
+					if (this->oneByteExtensions[id])
+						extIds.push_back(std::to_string(id));
 				}
 			}
 			else
 			{
-				extIds.reserve(this->mapTwoBytesExtensions.size());
-
-				for (auto& kv : this->mapTwoBytesExtensions)
+				for (size_t id{ 1 }; id < 256; ++id)
 				{
-					extIds.push_back(std::to_string(kv.first));
+					if (this->twoBytesExtensions[id])
+						extIds.push_back(std::to_string(id));
 				}
 			}
 
@@ -298,9 +340,11 @@ namespace RTC
 		this->ssrcAudioLevelExtensionId   = 0;
 		this->videoOrientationExtensionId = 0;
 
-		// Clear the One-Byte and Two-Bytes extension elements maps.
-		this->mapOneByteExtensions.clear();
-		this->mapTwoBytesExtensions.clear();
+		// Clear the extension elements table of the requested type.
+		if (type == 1u)
+			std::memset(this->oneByteExtensions, 0, sizeof(this->oneByteExtensions));
+		else if (type == 2u)
+			std::memset(this->twoBytesExtensions, 0, sizeof(this->twoBytesExtensions));
 
 		// If One-Byte is requested and the packet already has One-Byte extensions,
 		// keep the header extension id.
@@ -410,8 +454,8 @@ namespace RTC
 				if (extension.id == 0 || extension.id > 14 || extension.len == 0 || extension.len > 16)
 					continue;
 
-				// Store the One-Byte extension element in the map.
-				this->mapOneByteExtensions[extension.id] = reinterpret_cast<OneByteExtension*>(ptr);
+				// Store the One-Byte extension element in the table.
+				this->oneByteExtensions[extension.id] = reinterpret_cast<OneByteExtension*>(ptr);
 
 				*ptr = (extension.id << 4) | ((extension.len - 1) & 0x0F);
 				++ptr;
@@ -423,8 +467,8 @@ namespace RTC
 				if (extension.id == 0)
 					continue;
 
-				// Store the Two-Bytes extension element in the map.
-				this->mapTwoBytesExtensions[extension.id] = reinterpret_cast<TwoBytesExtension*>(ptr);
+				// Store the Two-Bytes extension element in the table.
+				this->twoBytesExtensions[extension.id] = reinterpret_cast<TwoBytesExtension*>(ptr);
 
 				*ptr = extension.id;
 				++ptr;
@@ -598,12 +642,12 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		if (!this->payloadDescriptorHandler)
+		if (!this->payloadDescriptorHandler.IsSet())
 			return true;
 
 		bool marker{ false };
 
-		if (this->payloadDescriptorHandler->Process(context, this->payload, marker))
+		if (this->payloadDescriptorHandler.Process(context, this->payload, marker))
 		{
 			if (marker)
 				SetMarker(true);
@@ -620,10 +664,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		if (!this->payloadDescriptorHandler)
+		if (!this->payloadDescriptorHandler.IsSet())
 			return;
 
-		this->payloadDescriptorHandler->Restore(this->payload);
+		this->payloadDescriptorHandler.Restore(this->payload);
 	}
 
 	void RtpPacket::ShiftPayload(size_t payloadOffset, size_t shift, bool expand)
@@ -661,6 +705,19 @@ namespace RTC
 		}
 	}
 
+	void RtpPacket::SetSharedPacket(RTC::SharedRtpPacket* sharedPacket)
+	{
+		MS_TRACE();
+
+		if (sharedPacket)
+			sharedPacket->AddRef();
+
+		if (this->sharedPacket)
+			this->sharedPacket->Release();
+
+		this->sharedPacket = sharedPacket;
+	}
+
 	void RtpPacket::ParseExtensions()
 	{
 		MS_TRACE();
@@ -668,8 +725,8 @@ namespace RTC
 		// Parse One-Byte header extension.
 		if (HasOneByteExtensions())
 		{
-			// Clear the One-Byte extension elements map.
-			this->mapOneByteExtensions.clear();
+			// Clear the One-Byte extension elements table.
+			std::memset(this->oneByteExtensions, 0, sizeof(this->oneByteExtensions));
 
 			uint8_t* extensionStart = reinterpret_cast<uint8_t*>(this->headerExtension) + 4;
 			uint8_t* extensionEnd   = extensionStart + GetHeaderExtensionLength();
@@ -696,8 +753,8 @@ namespace RTC
 						break;
 					}
 
-					// Store the One-Byte extension element in the map.
-					this->mapOneByteExtensions[id] = reinterpret_cast<OneByteExtension*>(ptr);
+					// Store the One-Byte extension element in the table.
+					this->oneByteExtensions[id] = reinterpret_cast<OneByteExtension*>(ptr);
 
 					ptr += (1 + len);
 				}
@@ -717,8 +774,8 @@ namespace RTC
 		// Parse Two-Bytes header extension.
 		else if (HasTwoBytesExtensions())
 		{
-			// Clear the Two-Bytes extension elements map.
-			this->mapTwoBytesExtensions.clear();
+			// Clear the Two-Bytes extension elements table.
+			std::memset(this->twoBytesExtensions, 0, sizeof(this->twoBytesExtensions));
 
 			uint8_t* extensionStart = reinterpret_cast<uint8_t*>(this->headerExtension) + 4;
 			uint8_t* extensionEnd   = extensionStart + GetHeaderExtensionLength();
@@ -744,8 +801,8 @@ namespace RTC
 						break;
 					}
 
-					// Store the Two-Bytes extension element in the map.
-					this->mapTwoBytesExtensions[id] = reinterpret_cast<TwoBytesExtension*>(ptr);
+					// Store the Two-Bytes extension element in the table.
+					this->twoBytesExtensions[id] = reinterpret_cast<TwoBytesExtension*>(ptr);
 
 					ptr += (2 + len);
 				}
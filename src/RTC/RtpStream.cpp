@@ -75,7 +75,34 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		uint16_t seq = packet->GetSequenceNumber();
+		return ReceiveSeq(packet->GetSsrc(), packet->GetSequenceNumber(), packet->GetTimestamp());
+	}
+
+	void RtpStream::ResetScore(uint8_t score, bool notify)
+	{
+		MS_TRACE();
+
+		this->totalSourceLoss   = 0;
+		this->totalReportedLoss = 0;
+		this->totalSentPackets  = 0;
+
+		this->scores.clear();
+
+		if (this->score != score)
+		{
+			auto previousScore = this->score;
+
+			this->score = score;
+
+			// Notify the listener.
+			if (notify)
+				this->listener->OnRtpStreamScore(this, score, previousScore);
+		}
+	}
+
+	bool RtpStream::ReceiveSeq(uint32_t ssrc, uint16_t seq, uint32_t timestamp)
+	{
+		MS_TRACE();
 
 		// If this is the first packet seen, initialize stuff.
 		if (!this->started)
@@ -84,59 +111,36 @@ namespace RTC
 
 			this->started     = true;
 			this->maxSeq      = seq - 1;
-			this->maxPacketTs = packet->GetTimestamp();
+			this->maxPacketTs = timestamp;
 			this->maxPacketMs = DepLibUV::GetTime();
 		}
 
 		// If not a valid packet ignore it.
-		if (!UpdateSeq(packet))
+		if (!UpdateSeq(ssrc, seq, timestamp))
 		{
 			MS_WARN_TAG(
 			  rtp,
 			  "invalid packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber());
+			  ssrc,
+			  seq);
 
 			return false;
 		}
 
 		// Update highest seen RTP timestamp.
-		if (RTC::SeqManager<uint32_t>::IsSeqHigherThan(packet->GetTimestamp(), this->maxPacketTs))
+		if (RTC::SeqManager<uint32_t>::IsSeqHigherThan(timestamp, this->maxPacketTs))
 		{
-			this->maxPacketTs = packet->GetTimestamp();
+			this->maxPacketTs = timestamp;
 			this->maxPacketMs = DepLibUV::GetTime();
 		}
 
 		return true;
 	}
 
-	void RtpStream::ResetScore(uint8_t score, bool notify)
-	{
-		MS_TRACE();
-
-		this->totalSourceLoss   = 0;
-		this->totalReportedLoss = 0;
-		this->totalSentPackets  = 0;
-
-		this->scores.clear();
-
-		if (this->score != score)
-		{
-			auto previousScore = this->score;
-
-			this->score = score;
-
-			// Notify the listener.
-			if (notify)
-				this->listener->OnRtpStreamScore(this, score, previousScore);
-		}
-	}
-
-	bool RtpStream::UpdateSeq(RTC::RtpPacket* packet)
+	bool RtpStream::UpdateSeq(uint32_t ssrc, uint16_t seq, uint32_t timestamp)
 	{
 		MS_TRACE();
 
-		uint16_t seq    = packet->GetSequenceNumber();
 		uint16_t udelta = seq - this->maxSeq;
 
 		// If the new packet sequence number is greater than the max seen but not
@@ -167,12 +171,12 @@ namespace RTC
 				MS_WARN_TAG(
 				  rtp,
 				  "too bad sequence number, re-syncing RTP [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-				  packet->GetSsrc(),
-				  packet->GetSequenceNumber());
+				  ssrc,
+				  seq);
 
 				InitSeq(seq);
 
-				this->maxPacketTs = packet->GetTimestamp();
+				this->maxPacketTs = timestamp;
 				this->maxPacketMs = DepLibUV::GetTime();
 			}
 			else
@@ -180,8 +184,8 @@ namespace RTC
 				MS_WARN_TAG(
 				  rtp,
 				  "bad sequence number, ignoring packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-				  packet->GetSsrc(),
-				  packet->GetSequenceNumber());
+				  ssrc,
+				  seq);
 
 				this->badSeq = (seq + 1) & (RtpSeqMod - 1);
 
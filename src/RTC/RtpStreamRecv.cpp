@@ -340,7 +340,8 @@ namespace RTC
 		  packet->GetSequenceNumber());
 
 		// If not a valid packet ignore it.
-		if (!RTC::RtpStream::UpdateSeq(packet))
+		if (!RTC::RtpStream::UpdateSeq(
+		      packet->GetSsrc(), packet->GetSequenceNumber(), packet->GetTimestamp()))
 		{
 			MS_WARN_TAG(
 			  rtx,
@@ -6,6 +6,7 @@
 #include "Logger.hpp"
 #include "Utils.hpp"
 #include "RTC/SeqManager.hpp"
+#include <srtp.h> // SRTP_MAX_TRAILER_LEN
 
 namespace RTC
 {
@@ -13,19 +14,44 @@ namespace RTC
 
 	// 17: 16 bit mask + the initial sequence number.
 	static constexpr size_t MaxRequestedPackets{ 17 };
-	static std::vector<RTC::RtpStreamSend::StorageItem*> RetransmissionContainer(MaxRequestedPackets + 1);
+	static thread_local RTC::RtpStreamSend::StorageItem* RetransmissionContainer[MaxRequestedPackets + 1];
+	// Packets rebuilt from the storage for retransmission (with extra space for
+	// RTX encoding and for in place SRTP encryption).
+	static constexpr size_t RetransmissionStoreSize{ RTC::MtuSize + 100 + SRTP_MAX_TRAILER_LEN };
+	static thread_local RTC::RtpPacket* RetransmissionPackets[MaxRequestedPackets];
+	static thread_local uint8_t RetransmissionStores[MaxRequestedPackets][RetransmissionStoreSize];
 	// Don't retransmit packets older than this (ms).
 	static constexpr uint32_t MaxRetransmissionDelay{ 2000 };
 	static constexpr uint32_t DefaultRtt{ 100 };
 
+	// Smallest power of two number of slots able to hold bufferSize packets.
+	inline static size_t getRingSize(size_t bufferSize)
+	{
+		size_t ringSize{ 1 };
+
+		while (ringSize < bufferSize && ringSize < 65536)
+		{
+			ringSize <<= 1;
+		}
+
+		return ringSize;
+	}
+
 	/* Instance methods. */
 
 	RtpStreamSend::RtpStreamSend(
 	  RTC::RtpStreamSend::Listener* listener, RTC::RtpStream::Params& params, size_t bufferSize)
-	  : RTC::RtpStream::RtpStream(listener, params, 10), buffer(bufferSize > 0 ? 65536 : 0, nullptr),
-	    storage(bufferSize)
+	  : RTC::RtpStream::RtpStream(listener, params, 10)
 	{
 		MS_TRACE();
+
+		if (bufferSize > 0)
+		{
+			auto ringSize = getRingSize(bufferSize);
+
+			this->buffer.resize(ringSize);
+			this->bufferMask = static_cast<uint16_t>(ringSize - 1);
+		}
 	}
 
 	RtpStreamSend::~RtpStreamSend()
@@ -58,16 +84,26 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		return ReceivePacket(RTC::EgressRtpPacket(packet));
+	}
+
+	bool RtpStreamSend::ReceivePacket(const RTC::EgressRtpPacket& egressPacket)
+	{
+		MS_TRACE();
+
 		// Call the parent method.
-		if (!RtpStream::ReceivePacket(packet))
+		if (!RtpStream::ReceiveSeq(
+		      egressPacket.GetSsrc(), egressPacket.GetSequenceNumber(), egressPacket.GetTimestamp()))
+		{
 			return false;
+		}
 
 		// If bufferSize was given, store the packet into the buffer.
-		if (!this->storage.empty())
-			StorePacket(packet);
+		if (!this->buffer.empty())
+			StorePacket(egressPacket);
 
 		// Increase transmission counter.
-		this->transmissionCounter.Update(packet);
+		this->transmissionCounter.Update(egressPacket.GetPacket());
 
 		return true;
 	}
@@ -86,14 +122,12 @@ namespace RTC
 
 			FillRetransmissionContainer(item->GetPacketId(), item->GetLostPacketBitmask());
 
-			for (auto* storageItem : RetransmissionContainer)
+			for (size_t containerIdx{ 0 }; RetransmissionContainer[containerIdx] != nullptr; ++containerIdx)
 			{
-				if (storageItem == nullptr)
-					break;
-
+				auto* storageItem = RetransmissionContainer[containerIdx];
 				// Note that this is an already RTX encoded packet if RTX is used
 				// (FillRetransmissionContainer() did it).
-				auto* packet = storageItem->packet;
+				auto* packet = RetransmissionPackets[containerIdx];
 
 				// Retransmit the packet.
 				static_cast<RTC::RtpStreamSend::Listener*>(this->listener)
@@ -105,6 +139,8 @@ namespace RTC
 				// Mark the packet as repaired (only if this is the first retransmission).
 				if (storageItem->sentTimes == 1)
 					RTC::RtpStream::PacketRepaired(packet);
+
+				delete packet;
 			}
 		}
 	}
@@ -226,37 +262,22 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		if (this->storage.empty())
+		if (this->buffer.empty())
 			return;
 
-		auto* storageItem = this->buffer[seq];
+		auto* storageItem = GetStorageItem(seq);
 
 		if (!storageItem)
 			return;
 
-		auto* packet = storageItem->packet;
-
-		// If we use RTX and the packet has not yet been resent, encode it now.
-		if (HasRtx())
-		{
-			// Increment RTX seq.
-			++this->rtxSeq;
-
-			if (!storageItem->rtxEncoded)
-			{
-				packet->RtxEncode(this->params.rtxPayloadType, this->params.rtxSsrc, this->rtxSeq);
-
-				storageItem->rtxEncoded = true;
-			}
-			else
-			{
-				packet->SetSequenceNumber(this->rtxSeq);
-			}
-		}
+		// Rebuild the packet (RTX encoded if RTX is used).
+		auto* packet = CloneStoredPacket(storageItem, seq, RetransmissionStores[0]);
 
 		// Retransmit as probation packet.
 		static_cast<RTC::RtpStreamSend::Listener*>(this->listener)
 		  ->OnRtpStreamRetransmitRtpPacket(this, packet, true);
+
+		delete packet;
 	}
 
 	uint32_t RtpStreamSend::GetBitrate(uint64_t /*now*/, uint8_t /*spatialLayer*/, uint8_t /*temporalLayer*/)
@@ -281,114 +302,84 @@ namespace RTC
 		MS_ABORT("invalid method call");
 	}
 
-	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet)
+	void RtpStreamSend::StorePacket(const RTC::EgressRtpPacket& egressPacket)
 	{
 		MS_TRACE();
 
+		auto* packet = egressPacket.GetPacket();
+
 		if (packet->GetSize() > RTC::MtuSize)
 		{
 			MS_WARN_TAG(
 			  rtp,
 			  "packet too big [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
 			  packet->GetSize());
 
 			return;
 		}
 
-		auto seq          = packet->GetSequenceNumber();
-		auto* storageItem = this->buffer[seq];
+		auto seq          = egressPacket.GetSequenceNumber();
+		auto* storageItem = std::addressof(this->buffer[seq & this->bufferMask]);
 
-		// Buffer is empty.
-		if (this->bufferSize == 0)
+		// The ring slot is already used. Check whether we should replace its
+		// content with the new packet or just ignore it (if duplicated packet).
+		if (storageItem->sharedPacket)
 		{
-			// Take the first storage position.
-			storageItem       = std::addressof(this->storage[0]);
-			this->buffer[seq] = storageItem;
-
-			// Increase buffer size and set start index.
-			this->bufferSize++;
-			this->bufferStartIdx = seq;
-		}
-		// The buffer item is already used. Check whether we should replace its
-		// storage with the new packet or just ignore it (if duplicated packet).
-		else if (storageItem)
-		{
-			auto* storedPacket = storageItem->packet;
-
-			if (packet->GetTimestamp() == storedPacket->GetTimestamp())
+			if (storageItem->seq == seq && storageItem->timestamp == egressPacket.GetTimestamp())
 				return;
 
 			// Reset the storage item.
 			ResetStorageItem(storageItem);
-
-			// If this was the item referenced by the buffer start index, move it to
-			// the next one.
-			if (this->bufferStartIdx == seq)
-				UpdateBufferStartIdx();
 		}
-		// Buffer not yet full, add an entry.
-		else if (this->bufferSize < this->storage.size())
-		{
-			// Take the next storage position.
-			storageItem       = std::addressof(this->storage[this->bufferSize]);
-			this->buffer[seq] = storageItem;
 
-			// Increase buffer size.
-			this->bufferSize++;
+		// Reference the copy of this packet stored by a previous consumer if its
+		// content is the same. Otherwise store a new copy and let next consumers of
+		// this packet reference it.
+		auto* sharedPacket = packet->GetSharedPacket();
+
+		if (sharedPacket && sharedPacket->Matches(packet))
+		{
+			sharedPacket->AddRef();
 		}
-		// Buffer full, remove oldest entry and add new one.
 		else
 		{
-			auto* firstStorageItem = this->buffer[this->bufferStartIdx];
+			sharedPacket = RTC::SharedRtpPacket::Create(packet);
 
-			// Reset the first storage item.
-			ResetStorageItem(firstStorageItem);
+			packet->SetSharedPacket(sharedPacket);
+		}
 
-			// Unfill the buffer start item.
-			this->buffer[this->bufferStartIdx] = nullptr;
+		storageItem->sharedPacket = sharedPacket;
+		storageItem->seq          = seq;
+		storageItem->timestamp    = egressPacket.GetTimestamp();
+	}
 
-			// Move the buffer start index.
-			UpdateBufferStartIdx();
+	/**
+	 * Returns the storage item holding the given seq (if any).
+	 */
+	inline RtpStreamSend::StorageItem* RtpStreamSend::GetStorageItem(uint16_t seq)
+	{
+		auto* storageItem = std::addressof(this->buffer[seq & this->bufferMask]);
 
-			// Take the freed storage item.
-			storageItem       = firstStorageItem;
-			this->buffer[seq] = storageItem;
-		}
+		if (!storageItem->sharedPacket || storageItem->seq != seq)
+			return nullptr;
 
-		// Clone the packet into the retrieved storage item.
-		storageItem->packet = packet->Clone(storageItem->store);
+		return storageItem;
 	}
 
 	void RtpStreamSend::ClearBuffer()
 	{
 		MS_TRACE();
 
-		if (this->storage.empty())
-			return;
-
-		for (uint32_t idx{ 0 }; idx < this->buffer.size(); ++idx)
+		for (auto& storageItem : this->buffer)
 		{
-			auto* storageItem = this->buffer[idx];
-
-			if (!storageItem)
-			{
-				MS_ASSERT(this->buffer[idx] == nullptr, "key should be NULL");
-
+			if (!storageItem.sharedPacket)
 				continue;
-			}
-
-			// Reset (free RTP packet) the storage item.
-			ResetStorageItem(storageItem);
 
-			// Unfill the buffer item.
-			this->buffer[idx] = nullptr;
+			// Reset (release RTP packet) the storage item.
+			ResetStorageItem(std::addressof(storageItem));
 		}
-
-		// Reset buffer.
-		this->bufferStartIdx = 0;
-		this->bufferSize     = 0;
 	}
 
 	inline void RtpStreamSend::ResetStorageItem(StorageItem* storageItem)
@@ -397,40 +388,20 @@ namespace RTC
 
 		MS_ASSERT(storageItem, "storageItem cannot be nullptr");
 
-		delete storageItem->packet;
+		storageItem->sharedPacket->Release();
 
-		storageItem->packet       = nullptr;
+		storageItem->sharedPacket = nullptr;
+		storageItem->seq          = 0;
+		storageItem->timestamp    = 0;
 		storageItem->resentAtTime = 0;
 		storageItem->sentTimes    = 0;
-		storageItem->rtxEncoded   = false;
-	}
-
-	/**
-	 * Iterates the buffer starting from the current start idx + 1 until next
-	 * used one. It takes into account that the buffer is circular.
-	 */
-	inline void RtpStreamSend::UpdateBufferStartIdx()
-	{
-		uint16_t seq = this->bufferStartIdx + 1;
-
-		for (uint32_t idx{ 0 }; idx < this->buffer.size(); ++idx, ++seq)
-		{
-			auto* storageItem = this->buffer[seq];
-
-			if (storageItem)
-			{
-				this->bufferStartIdx = seq;
-
-				break;
-			}
-		}
 	}
 
 	// This method looks for the requested RTP packets and inserts them into the
-	// RetransmissionContainer vector (and sets to null the next position).
+	// RetransmissionContainer array (and sets to null the next position).
 	//
-	// If RTX is used the stored packet will be RTX encoded now (if not already
-	// encoded in a previous resend).
+	// Each inserted packet is rebuilt into the RetransmissionPackets array (RTX
+	// encoded if RTX is used).
 	void RtpStreamSend::FillRetransmissionContainer(uint16_t seq, uint16_t bitmask)
 	{
 		MS_TRACE();
@@ -466,17 +437,14 @@ namespace RTC
 
 			if (requested)
 			{
-				auto* storageItem = this->buffer[seq];
-				RTC::RtpPacket* packet{ nullptr };
+				auto* storageItem = GetStorageItem(seq);
 				uint32_t diffMs;
 
 				// Calculate how the elapsed time between the max timestampt seen and
 				// the requested packet's timestampt (in ms).
 				if (storageItem)
 				{
-					packet = storageItem->packet;
-
-					uint32_t diffTs = this->maxPacketTs - packet->GetTimestamp();
+					uint32_t diffTs = this->maxPacketTs - storageItem->timestamp;
 
 					diffMs = diffTs * 1000 / this->params.clockRate;
 				}
@@ -495,7 +463,7 @@ namespace RTC
 						  rtx,
 						  "ignoring retransmission for too old packet "
 						  "[seq:%" PRIu16 ", max age:%" PRIu32 "ms, packet age:%" PRIu32 "ms]",
-						  packet->GetSequenceNumber(),
+						  seq,
 						  MaxRetransmissionDelay,
 						  diffMs);
 
@@ -514,29 +482,15 @@ namespace RTC
 					  rtx,
 					  "ignoring retransmission for a packet already resent in the last RTT ms "
 					  "[seq:%" PRIu16 ", rtt:%" PRIu32 "]",
-					  packet->GetSequenceNumber(),
+					  seq,
 					  rtt);
 				}
 				// Stored packet is valid for retransmission. Resend it.
 				else
 				{
-					// If we use RTX and the packet has not yet been resent, encode it now.
-					if (HasRtx())
-					{
-						// Increment RTX seq.
-						++this->rtxSeq;
-
-						if (!storageItem->rtxEncoded)
-						{
-							packet->RtxEncode(this->params.rtxPayloadType, this->params.rtxSsrc, this->rtxSeq);
-
-							storageItem->rtxEncoded = true;
-						}
-						else
-						{
-							packet->SetSequenceNumber(this->rtxSeq);
-						}
-					}
+					// Rebuild the packet into the container's slot.
+					RetransmissionPackets[containerIdx] =
+					  CloneStoredPacket(storageItem, seq, RetransmissionStores[containerIdx]);
 
 					// Save when this packet was resent.
 					storageItem->resentAtTime = now;
@@ -595,6 +549,35 @@ namespace RTC
 		RetransmissionContainer[containerIdx] = nullptr;
 	}
 
+	/**
+	 * Clones the stored packet into the given buffer, applies the fields written
+	 * by this stream and RTX encodes it if RTX is used.
+	 */
+	inline RTC::RtpPacket* RtpStreamSend::CloneStoredPacket(
+	  StorageItem* storageItem, uint16_t seq, uint8_t* buffer)
+	{
+		MS_TRACE();
+
+		auto* packet = storageItem->sharedPacket->Clone(buffer);
+
+		// Let the transport encrypt the packet in place.
+		packet->SetBufferLength(RetransmissionStoreSize);
+
+		packet->SetSsrc(this->params.ssrc);
+		packet->SetSequenceNumber(seq);
+		packet->SetTimestamp(storageItem->timestamp);
+
+		if (HasRtx())
+		{
+			// Increment RTX seq.
+			++this->rtxSeq;
+
+			packet->RtxEncode(this->params.rtxPayloadType, this->params.rtxSsrc, this->rtxSeq);
+		}
+
+		return packet;
+	}
+
 	void RtpStreamSend::UpdateScore(RTC::RTCP::ReceiverReport* report)
 	{
 		MS_TRACE();
@@ -0,0 +1,746 @@
+#define MS_CLASS "RTC::SharedMemoryPipe"
+// #define MS_LOG_DEV
+
+#include "RTC/SharedMemoryPipe.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <algorithm> // std::find()
+#include <atomic>
+#include <cerrno>
+#include <cstdlib> // std::strtoll()
+#include <cstring> // std::memcpy(), std::strerror()
+#include <new>     // placement new
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/* Static. */
+
+// Names are "mediasoup:<pid>:<id>".
+static const std::string NamePrefix{ "mediasoup:" };
+// Data area of each ring (power of two).
+static constexpr size_t RingDataSize{ 4 * 1024 * 1024 };
+static constexpr size_t RingDataMask{ RingDataSize - 1 };
+// The data area starts at the second page, right after the ring header.
+static constexpr size_t RingDataOffset{ 4096 };
+static constexpr size_t RingMemSize{ RingDataOffset + RingDataSize };
+// Each frame is prefixed by its length and padded to 4 bytes.
+static constexpr size_t FrameHeaderSize{ 4 };
+static constexpr uint32_t FrameWrapMarker{ 0xFFFFFFFF };
+static constexpr size_t MaxFrameLen{ RTC::RtpBufferSize };
+static thread_local uint8_t ReadBuffer[MaxFrameLen];
+
+/* Ring header at the beginning of the shared memory. */
+struct RingHeader
+{
+	// Written by the reader.
+	std::atomic<uint64_t> head{ 0 };
+	uint8_t headPadding[64 - sizeof(std::atomic<uint64_t>)];
+	// Written by the writer.
+	std::atomic<uint64_t> tail{ 0 };
+	uint8_t tailPadding[64 - sizeof(std::atomic<uint64_t>)];
+	// Set by the writer when it wakes up the reader and cleared by the reader
+	// before draining the ring.
+	std::atomic<uint32_t> signaled{ 0 };
+};
+
+static_assert(sizeof(RingHeader) <= RingDataOffset, "RingHeader does not fit");
+// Atomics are shared between processes so they must not rely on locks.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64 bits atomics are not lock free");
+
+/* Static methods for UV callbacks. */
+
+inline static void onListenReadable(uv_poll_t* handle, int /*status*/, int /*events*/)
+{
+	static_cast<RTC::SharedMemoryPipe*>(handle->data)->OnUvListenReadable();
+}
+
+inline static void onConnectReadable(uv_poll_t* handle, int /*status*/, int /*events*/)
+{
+	static_cast<RTC::SharedMemoryPipe*>(handle->data)->OnUvConnectReadable();
+}
+
+inline static void onEventFdReadable(uv_poll_t* handle, int /*status*/, int /*events*/)
+{
+	static_cast<RTC::SharedMemoryPipe*>(handle->data)->OnUvEventFdReadable();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+inline static void closePoll(uv_poll_t* handle)
+{
+	uv_poll_stop(handle);
+	uv_close(reinterpret_cast<uv_handle_t*>(handle), static_cast<uv_close_cb>(onClose));
+}
+
+namespace RTC
+{
+	/* Class variables. */
+
+	thread_local std::vector<SharedMemoryPipe*> SharedMemoryPipe::pendingPipes;
+
+	/* Class methods. */
+
+	void SharedMemoryPipe::ClassInit()
+	{
+		MS_TRACE();
+
+		DepLibUV::AddFlushCallback(SharedMemoryPipe::FlushAll);
+	}
+
+	void SharedMemoryPipe::FlushAll()
+	{
+		if (SharedMemoryPipe::pendingPipes.empty())
+			return;
+
+		for (auto* pipe : SharedMemoryPipe::pendingPipes)
+		{
+			pipe->WakeUpRemote();
+		}
+
+		SharedMemoryPipe::pendingPipes.clear();
+	}
+
+	/* Instance methods. */
+
+#ifdef __linux__
+	SharedMemoryPipe::SharedMemoryPipe(Listener* listener, const std::string& id)
+	  : listener(listener), name(NamePrefix + std::to_string(Logger::pid) + ":" + id)
+	{
+		MS_TRACE();
+
+		struct sockaddr_un addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		// Abstract namespace (leading NUL byte).
+		if (this->name.size() + 1 > sizeof(addr.sun_path))
+			MS_THROW_TYPE_ERROR("id too long for a shared memory pipe name");
+
+		try
+		{
+			// Ring we read from.
+			this->localMemFd = memfd_create("mediasoup-pipe", MFD_CLOEXEC);
+
+			if (this->localMemFd == -1)
+				MS_THROW_ERROR("memfd_create() failed: %s", std::strerror(errno));
+
+			if (ftruncate(this->localMemFd, RingMemSize) == -1)
+				MS_THROW_ERROR("ftruncate() failed: %s", std::strerror(errno));
+
+			void* mem =
+			  mmap(nullptr, RingMemSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->localMemFd, 0);
+
+			if (mem == MAP_FAILED)
+				MS_THROW_ERROR("mmap() failed: %s", std::strerror(errno));
+
+			this->localRing = static_cast<uint8_t*>(mem);
+
+			new (this->localRing) RingHeader();
+
+			// Wakeups of the local ring.
+			this->localEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			if (this->localEventFd == -1)
+				MS_THROW_ERROR("eventfd() failed: %s", std::strerror(errno));
+
+			// Socket the remote side connects to in order to get our fds.
+			this->listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+			if (this->listenFd == -1)
+				MS_THROW_ERROR("socket() failed: %s", std::strerror(errno));
+
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			std::memcpy(addr.sun_path + 1, this->name.data(), this->name.size());
+
+			auto addrLen =
+			  static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + 1 + this->name.size());
+
+			if (bind(this->listenFd, reinterpret_cast<struct sockaddr*>(&addr), addrLen) == -1)
+				MS_THROW_ERROR("bind() failed: %s", std::strerror(errno));
+
+			if (listen(this->listenFd, 8) == -1)
+				MS_THROW_ERROR("listen() failed: %s", std::strerror(errno));
+
+			this->listenUvHandle       = new uv_poll_t;
+			this->listenUvHandle->data = (void*)this;
+
+			int err = uv_poll_init(DepLibUV::GetLoop(), this->listenUvHandle, this->listenFd);
+
+			if (err != 0)
+			{
+				delete this->listenUvHandle;
+				this->listenUvHandle = nullptr;
+
+				MS_THROW_ERROR("uv_poll_init() failed: %s", uv_strerror(err));
+			}
+
+			// NOTE: Connections are not accepted until Connect() tells us who the
+			// remote side is, they wait in the backlog meanwhile.
+
+			this->eventUvHandle       = new uv_poll_t;
+			this->eventUvHandle->data = (void*)this;
+
+			err = uv_poll_init(DepLibUV::GetLoop(), this->eventUvHandle, this->localEventFd);
+
+			if (err != 0)
+			{
+				delete this->eventUvHandle;
+				this->eventUvHandle = nullptr;
+
+				MS_THROW_ERROR("uv_poll_init() failed: %s", uv_strerror(err));
+			}
+
+			uv_poll_start(this->eventUvHandle, UV_READABLE, static_cast<uv_poll_cb>(onEventFdReadable));
+		}
+		catch (const MediaSoupError& error)
+		{
+			// Must free everything since the destructor won't be called.
+			Close();
+
+			throw;
+		}
+	}
+
+	SharedMemoryPipe::~SharedMemoryPipe()
+	{
+		MS_TRACE();
+
+		Close();
+	}
+
+	void SharedMemoryPipe::Close()
+	{
+		MS_TRACE();
+
+		if (this->wakeUpPending)
+		{
+			SharedMemoryPipe::pendingPipes.erase(std::find(
+			  SharedMemoryPipe::pendingPipes.begin(), SharedMemoryPipe::pendingPipes.end(), this));
+
+			this->wakeUpPending = false;
+		}
+
+		if (this->listenUvHandle != nullptr)
+		{
+			closePoll(this->listenUvHandle);
+			this->listenUvHandle = nullptr;
+		}
+
+		if (this->connectUvHandle != nullptr)
+		{
+			closePoll(this->connectUvHandle);
+			this->connectUvHandle = nullptr;
+		}
+
+		if (this->eventUvHandle != nullptr)
+		{
+			closePoll(this->eventUvHandle);
+			this->eventUvHandle = nullptr;
+		}
+
+		// NOTE: uv_poll_t handles do not own their fds so they can be closed now.
+		int* fds[] = {
+			&this->listenFd, &this->connectFd, &this->localMemFd, &this->localEventFd, &this->remoteEventFd
+		};
+
+		for (int* fd : fds)
+		{
+			if (*fd != -1)
+			{
+				close(*fd);
+				*fd = -1;
+			}
+		}
+
+		// The remote side keeps its own mappings, so it is safe to unmap ours.
+		if (this->localRing != nullptr)
+		{
+			munmap(this->localRing, RingMemSize);
+			this->localRing = nullptr;
+		}
+
+		if (this->remoteRing != nullptr)
+		{
+			munmap(this->remoteRing, RingMemSize);
+			this->remoteRing = nullptr;
+		}
+	}
+
+	/**
+	 * Connects to the SharedMemoryPipe with the given name (in this or in another
+	 * worker). The listener is notified once the remote ring has been mapped, or
+	 * if it could not be. It is also notified if the pipe is closed later due to
+	 * a corrupted ring.
+	 */
+	void SharedMemoryPipe::Connect(const std::string& name)
+	{
+		MS_TRACE();
+
+		if (this->localRing == nullptr)
+			MS_THROW_ERROR("shared memory pipe closed");
+		else if (this->connectFd != -1 || this->remoteRing != nullptr)
+			MS_THROW_ERROR("already connected or connecting");
+
+		struct sockaddr_un addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		// clang-format off
+		if (
+			name.size() + 1 > sizeof(addr.sun_path) ||
+			name.compare(0, NamePrefix.size(), NamePrefix) != 0
+		)
+		// clang-format on
+		{
+			MS_THROW_TYPE_ERROR("invalid shared memory pipe name");
+		}
+
+		char* pidEnd{ nullptr };
+		const char* pidStr = name.c_str() + NamePrefix.size();
+		int64_t remotePid  = std::strtoll(pidStr, &pidEnd, 10);
+
+		if (pidEnd == pidStr || *pidEnd != ':' || remotePid <= 0)
+			MS_THROW_TYPE_ERROR("invalid shared memory pipe name");
+
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		std::memcpy(addr.sun_path + 1, name.data(), name.size());
+
+		auto addrLen = static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + 1 + name.size());
+
+		int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+		if (fd == -1)
+			MS_THROW_ERROR("socket() failed: %s", std::strerror(errno));
+
+		// Connecting to a listening Unix socket does not block.
+		if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), addrLen) == -1)
+		{
+			int error = errno;
+
+			close(fd);
+
+			MS_THROW_ERROR("connect() failed: %s", std::strerror(error));
+		}
+
+		this->connectUvHandle       = new uv_poll_t;
+		this->connectUvHandle->data = (void*)this;
+
+		int err = uv_poll_init(DepLibUV::GetLoop(), this->connectUvHandle, fd);
+
+		if (err != 0)
+		{
+			delete this->connectUvHandle;
+			this->connectUvHandle = nullptr;
+
+			close(fd);
+
+			MS_THROW_ERROR("uv_poll_init() failed: %s", uv_strerror(err));
+		}
+
+		this->connectFd = fd;
+		this->remotePid = remotePid;
+
+		uv_poll_start(this->connectUvHandle, UV_READABLE, static_cast<uv_poll_cb>(onConnectReadable));
+
+		// Now we know who may connect to us.
+		if (this->listenUvHandle != nullptr)
+			uv_poll_start(this->listenUvHandle, UV_READABLE, static_cast<uv_poll_cb>(onListenReadable));
+	}
+
+	/**
+	 * Writes a frame (made of the given parts) into the remote ring. Returns
+	 * false if not connected or if there is no room (the frame is dropped).
+	 */
+	bool SharedMemoryPipe::Send(const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2)
+	{
+		MS_TRACE();
+
+		if (this->remoteRing == nullptr)
+			return false;
+
+		size_t len = len1 + len2;
+
+		if (len > MaxFrameLen)
+		{
+			MS_WARN_DEV("frame too big [len:%zu]", len);
+
+			return false;
+		}
+
+		auto* header     = reinterpret_cast<RingHeader*>(this->remoteRing);
+		uint8_t* data    = this->remoteRing + RingDataOffset;
+		size_t frameSize = (FrameHeaderSize + len + 3) & ~size_t{ 3 };
+		uint64_t tail    = header->tail.load(std::memory_order_relaxed);
+		uint64_t head    = header->head.load(std::memory_order_acquire);
+		size_t offset    = tail & RingDataMask;
+		// Frames are not split, so skip the end of the data area if needed.
+		size_t padding = offset + frameSize > RingDataSize ? RingDataSize - offset : 0;
+
+		if (RingDataSize - (tail - head) < padding + frameSize)
+		{
+			MS_DEBUG_DEV("ring full, frame dropped");
+
+			return false;
+		}
+
+		if (padding != 0)
+		{
+			std::memcpy(data + offset, &FrameWrapMarker, FrameHeaderSize);
+
+			tail += padding;
+			offset = 0;
+		}
+
+		auto frameLen = static_cast<uint32_t>(len);
+
+		std::memcpy(data + offset, &frameLen, FrameHeaderSize);
+		std::memcpy(data + offset + FrameHeaderSize, data1, len1);
+
+		if (len2 != 0)
+			std::memcpy(data + offset + FrameHeaderSize + len1, data2, len2);
+
+		header->tail.store(tail + frameSize, std::memory_order_release);
+
+		// Wake up the remote side once the loop iteration ends.
+		if (!this->wakeUpPending)
+		{
+			this->wakeUpPending = true;
+
+			SharedMemoryPipe::pendingPipes.push_back(this);
+		}
+
+		return true;
+	}
+
+	void SharedMemoryPipe::WakeUpRemote()
+	{
+		MS_TRACE();
+
+		this->wakeUpPending = false;
+
+		if (this->remoteRing == nullptr)
+			return;
+
+		auto* header = reinterpret_cast<RingHeader*>(this->remoteRing);
+
+		// Already woken up and not drained yet.
+		if (header->signaled.exchange(1) != 0)
+			return;
+
+		uint64_t value{ 1 };
+
+		if (write(this->remoteEventFd, &value, sizeof(value)) == -1)
+			MS_DEBUG_DEV("write() to eventfd failed: %s", std::strerror(errno));
+	}
+
+	void SharedMemoryPipe::ReadLocalRing()
+	{
+		MS_TRACE();
+
+		auto* header  = reinterpret_cast<RingHeader*>(this->localRing);
+		uint8_t* data = this->localRing + RingDataOffset;
+
+		// Frames written from now on will wake us up again.
+		header->signaled.store(0);
+
+		uint64_t head = header->head.load(std::memory_order_relaxed);
+		uint64_t tail = header->tail.load();
+
+		// Don't trust the remote side (it may even write the head).
+		if (tail < head)
+		{
+			CloseCorrupted();
+
+			return;
+		}
+
+		while (head < tail)
+		{
+			size_t available = tail - head;
+			size_t offset    = head & RingDataMask;
+
+			// Frames (and so the head) are 4 bytes aligned.
+			if (available > RingDataSize || available < FrameHeaderSize || (offset & 3) != 0)
+			{
+				CloseCorrupted();
+
+				return;
+			}
+
+			uint32_t frameLen;
+
+			std::memcpy(&frameLen, data + offset, FrameHeaderSize);
+
+			if (frameLen == FrameWrapMarker && RingDataSize - offset <= available)
+			{
+				head += RingDataSize - offset;
+
+				continue;
+			}
+
+			size_t frameSize = (FrameHeaderSize + size_t{ frameLen } + 3) & ~size_t{ 3 };
+
+			if (frameLen > MaxFrameLen || frameSize > available || frameSize > RingDataSize - offset)
+			{
+				CloseCorrupted();
+
+				return;
+			}
+
+			// Copy it since the packet may be modified (and grow) while processed,
+			// and so the writer can reuse the room.
+			std::memcpy(ReadBuffer, data + offset + FrameHeaderSize, frameLen);
+
+			head += frameSize;
+
+			header->head.store(head, std::memory_order_release);
+
+			this->listener->OnSharedMemoryPipePacketReceived(this, ReadBuffer, frameLen);
+
+			if (head == tail)
+			{
+				tail = header->tail.load(std::memory_order_acquire);
+
+				if (tail < head)
+				{
+					CloseCorrupted();
+
+					return;
+				}
+			}
+		}
+	}
+
+	void SharedMemoryPipe::CloseCorrupted()
+	{
+		MS_TRACE();
+
+		MS_WARN_TAG(rtp, "invalid shared memory ring content, closing the pipe");
+
+		Close();
+
+		this->listener->OnSharedMemoryPipeFailed(this);
+	}
+
+	inline void SharedMemoryPipe::OnUvListenReadable()
+	{
+		MS_TRACE();
+
+		int fd = accept4(this->listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+
+		if (fd == -1)
+		{
+			MS_DEBUG_DEV("accept4() failed: %s", std::strerror(errno));
+
+			return;
+		}
+
+		struct ucred cred; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		socklen_t credLen = sizeof(cred);
+
+		// Just give our ring to the worker we are connecting to.
+		// clang-format off
+		if (
+			getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credLen) == -1 ||
+			cred.uid != geteuid() ||
+			static_cast<int64_t>(cred.pid) != this->remotePid
+		)
+		// clang-format on
+		{
+			MS_WARN_TAG(rtp, "rejecting shared memory pipe connection from unexpected peer");
+
+			close(fd);
+
+			return;
+		}
+
+		// Give our ring and our eventfd.
+		int fds[2] = { this->localMemFd, this->localEventFd };
+		uint8_t byte{ 0 };
+		struct iovec iov = { &byte, sizeof(byte) };
+		uint8_t control[CMSG_SPACE(sizeof(fds))];
+		struct msghdr msg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		std::memset(&msg, 0, sizeof(msg));
+		std::memset(control, 0, sizeof(control));
+		msg.msg_iov        = &iov;
+		msg.msg_iovlen     = 1;
+		msg.msg_control    = control;
+		msg.msg_controllen = sizeof(control);
+
+		auto* cmsg       = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type  = SCM_RIGHTS;
+		cmsg->cmsg_len   = CMSG_LEN(sizeof(fds));
+
+		std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+		if (sendmsg(fd, &msg, MSG_NOSIGNAL) == -1)
+		{
+			MS_WARN_TAG(rtp, "sendmsg() failed: %s", std::strerror(errno));
+
+			close(fd);
+
+			return;
+		}
+
+		close(fd);
+
+		// The remote side got our ring, nobody else may connect.
+		closePoll(this->listenUvHandle);
+		this->listenUvHandle = nullptr;
+		close(this->listenFd);
+		this->listenFd = -1;
+	}
+
+	inline void SharedMemoryPipe::OnUvConnectReadable()
+	{
+		MS_TRACE();
+
+		int fds[2] = { -1, -1 };
+		uint8_t byte;
+		struct iovec iov = { &byte, sizeof(byte) };
+		uint8_t control[CMSG_SPACE(sizeof(fds))];
+		struct msghdr msg; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		std::memset(&msg, 0, sizeof(msg));
+		msg.msg_iov        = &iov;
+		msg.msg_iovlen     = 1;
+		msg.msg_control    = control;
+		msg.msg_controllen = sizeof(control);
+
+		ssize_t ret = recvmsg(this->connectFd, &msg, MSG_CMSG_CLOEXEC);
+
+		if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return;
+
+		// Done with the connection anyway.
+		closePoll(this->connectUvHandle);
+		this->connectUvHandle = nullptr;
+		close(this->connectFd);
+		this->connectFd = -1;
+
+		auto* cmsg = ret > 0 ? CMSG_FIRSTHDR(&msg) : nullptr;
+
+		if (
+		  cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+		  cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+		{
+			MS_WARN_TAG(rtp, "remote shared memory pipe did not give its ring");
+
+			this->listener->OnSharedMemoryPipeFailed(this);
+
+			return;
+		}
+
+		std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+		struct stat st; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		void* mem{ MAP_FAILED };
+
+		if (fstat(fds[0], &st) == 0 && static_cast<size_t>(st.st_size) == RingMemSize)
+			mem = mmap(nullptr, RingMemSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+
+		// The mapping keeps the memory alive.
+		close(fds[0]);
+
+		if (mem == MAP_FAILED)
+		{
+			MS_WARN_TAG(rtp, "could not map the remote shared memory ring");
+
+			close(fds[1]);
+
+			this->listener->OnSharedMemoryPipeFailed(this);
+
+			return;
+		}
+
+		this->remoteRing    = static_cast<uint8_t*>(mem);
+		this->remoteEventFd = fds[1];
+
+		this->listener->OnSharedMemoryPipeConnected(this);
+	}
+
+	inline void SharedMemoryPipe::OnUvEventFdReadable()
+	{
+		MS_TRACE();
+
+		uint64_t value;
+
+		// Reset the eventfd counter.
+		if (read(this->localEventFd, &value, sizeof(value)) == -1 && errno != EAGAIN)
+			MS_DEBUG_DEV("read() from eventfd failed: %s", std::strerror(errno));
+
+		ReadLocalRing();
+	}
+#else
+	SharedMemoryPipe::SharedMemoryPipe(Listener* /*listener*/, const std::string& /*id*/)
+	{
+		MS_TRACE();
+
+		MS_THROW_TYPE_ERROR("shared memory pipes are just supported on Linux");
+	}
+
+	SharedMemoryPipe::~SharedMemoryPipe()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::Close()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::Connect(const std::string& /*name*/)
+	{
+		MS_TRACE();
+	}
+
+	bool SharedMemoryPipe::Send(
+	  const uint8_t* /*data1*/, size_t /*len1*/, const uint8_t* /*data2*/, size_t /*len2*/)
+	{
+		MS_TRACE();
+
+		return false;
+	}
+
+	void SharedMemoryPipe::WakeUpRemote()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::ReadLocalRing()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::CloseCorrupted()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::OnUvListenReadable()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::OnUvConnectReadable()
+	{
+		MS_TRACE();
+	}
+
+	void SharedMemoryPipe::OnUvEventFdReadable()
+	{
+		MS_TRACE();
+	}
+#endif
+} // namespace RTC
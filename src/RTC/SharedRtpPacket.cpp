@@ -0,0 +1,97 @@
+#define MS_CLASS "RTC::SharedRtpPacket"
+// #define MS_LOG_DEV
+
+#include "RTC/SharedRtpPacket.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t MaxPooledSharedRtpPackets{ 1024 };
+	static thread_local std::vector<SharedRtpPacket*> SharedRtpPacketPool;
+
+	/* Class methods. */
+
+	SharedRtpPacket* SharedRtpPacket::Create(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(packet->GetSize() <= RTC::MtuSize, "packet too big");
+
+		SharedRtpPacket* sharedPacket;
+
+		if (!SharedRtpPacketPool.empty())
+		{
+			sharedPacket = SharedRtpPacketPool.back();
+
+			SharedRtpPacketPool.pop_back();
+		}
+		else
+		{
+			sharedPacket = new SharedRtpPacket();
+		}
+
+		sharedPacket->packet   = packet->Clone(sharedPacket->store);
+		sharedPacket->refCount     = 1;
+		sharedPacket->payloadState = packet->GetPayloadState();
+
+		return sharedPacket;
+	}
+
+	void SharedRtpPacket::ClassDestroy()
+	{
+		MS_TRACE();
+
+		for (auto* sharedPacket : SharedRtpPacketPool)
+		{
+			delete sharedPacket;
+		}
+
+		SharedRtpPacketPool.clear();
+	}
+
+	/* Instance methods. */
+
+	void SharedRtpPacket::Release()
+	{
+		MS_TRACE();
+
+		MS_ASSERT(this->refCount > 0, "refCount is already 0");
+
+		if (--this->refCount != 0)
+			return;
+
+		delete this->packet;
+		this->packet = nullptr;
+
+		if (SharedRtpPacketPool.size() < MaxPooledSharedRtpPackets)
+			SharedRtpPacketPool.push_back(this);
+		else
+			delete this;
+	}
+
+	/**
+	 * Whether the given packet, which must be the one this copy was created from,
+	 * still carries the same content, just ignoring the sequence number, timestamp
+	 * and ssrc fields which consumers rewrite. Its payload is only modified by
+	 * payload descriptor rewrites, which change its payload state, so the payload
+	 * is not compared.
+	 */
+	bool SharedRtpPacket::Matches(const RTC::RtpPacket* packet) const
+	{
+		MS_TRACE();
+
+		auto* data       = this->packet->GetData();
+		auto* packetData = packet->GetData();
+
+		// clang-format off
+		return (
+			packet->GetSize() == this->packet->GetSize() &&
+			data[0] == packetData[0] &&
+			data[1] == packetData[1] &&
+			packet->GetPayloadState() == this->payloadState
+		);
+		// clang-format on
+	}
+} // namespace RTC
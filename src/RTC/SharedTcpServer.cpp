@@ -0,0 +1,264 @@
+#define MS_CLASS "RTC::SharedTcpServer"
+// #define MS_LOG_DEV
+
+#include "RTC/SharedTcpServer.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "RTC/StunPacket.hpp"
+#include <vector>
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t MaxTcpConnectionsPerSharedServer{ 65536 };
+	// Time (in ms) a connection has to send its first STUN Binding Request.
+	static constexpr uint64_t UnboundConnectionTimeout{ 5000 };
+	static constexpr uint64_t UnboundConnectionCheckInterval{ 1000 };
+
+	/* Class variables. */
+
+	thread_local std::unordered_map<std::string, SharedTcpServer*> SharedTcpServer::mapIpSharedTcpServers;
+
+	/* Class methods. */
+
+	SharedTcpServer* SharedTcpServer::Acquire(std::string& ip)
+	{
+		MS_TRACE();
+
+		SharedTcpServer* sharedTcpServer;
+		auto it = SharedTcpServer::mapIpSharedTcpServers.find(ip);
+
+		if (it != SharedTcpServer::mapIpSharedTcpServers.end())
+		{
+			sharedTcpServer = it->second;
+		}
+		else
+		{
+			// This may throw.
+			sharedTcpServer = new SharedTcpServer(ip);
+
+			SharedTcpServer::mapIpSharedTcpServers[ip] = sharedTcpServer;
+		}
+
+		++sharedTcpServer->refCount;
+
+		return sharedTcpServer;
+	}
+
+	void SharedTcpServer::Release(SharedTcpServer* sharedTcpServer)
+	{
+		MS_TRACE();
+
+		if (--sharedTcpServer->refCount != 0)
+			return;
+
+		SharedTcpServer::mapIpSharedTcpServers.erase(sharedTcpServer->ip);
+
+		delete sharedTcpServer;
+	}
+
+	/* Instance methods. */
+
+	SharedTcpServer::SharedTcpServer(std::string& ip)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		this->tcpServer = new RTC::TcpServer(this, this, ip, MaxTcpConnectionsPerSharedServer);
+
+		// Store the normalized IP.
+		this->ip = ip;
+
+		this->unboundTimer = new Timer(this);
+	}
+
+	SharedTcpServer::~SharedTcpServer()
+	{
+		MS_TRACE();
+
+		// Clear the maps first so closing connections are not notified to anybody.
+		this->mapConnectionListeners.clear();
+		this->mapUnboundConnectionTimes.clear();
+
+		delete this->unboundTimer;
+
+		delete this->tcpServer;
+	}
+
+	void SharedTcpServer::AddUsernameFragment(
+	  const std::string& usernameFragment,
+	  RTC::TcpServer::Listener* listener,
+	  RTC::TcpConnection::Listener* connListener)
+	{
+		MS_TRACE();
+
+		this->mapUsernameFragmentListeners[usernameFragment] = { listener, connListener };
+	}
+
+	void SharedTcpServer::RemoveListener(RTC::TcpServer::Listener* listener)
+	{
+		MS_TRACE();
+
+		for (auto it = this->mapUsernameFragmentListeners.begin();
+		     it != this->mapUsernameFragmentListeners.end();)
+		{
+			if (it->second.listener == listener)
+				it = this->mapUsernameFragmentListeners.erase(it);
+			else
+				++it;
+		}
+
+		// Close the connections of the transport (as its own TcpServer would do).
+		std::vector<RTC::TcpConnection*> connections;
+
+		for (auto it = this->mapConnectionListeners.begin(); it != this->mapConnectionListeners.end();)
+		{
+			if (it->second.listener == listener)
+			{
+				connections.push_back(it->first);
+
+				it = this->mapConnectionListeners.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// NOTE: This makes the TcpServer delete the connection.
+		for (auto* connection : connections)
+		{
+			connection->ErrorReceiving();
+		}
+	}
+
+	/**
+	 * Stops reading from a not yet bound connection. It is deleted by the next
+	 * check of unbound connections, since it cannot be while it is delivering
+	 * the frame.
+	 */
+	void SharedTcpServer::RejectConnection(RTC::TcpConnection* connection)
+	{
+		MS_TRACE();
+
+		connection->Close();
+	}
+
+	inline void SharedTcpServer::OnRtcTcpConnectionAccepted(
+	  RTC::TcpServer* /*tcpServer*/, RTC::TcpConnection* connection)
+	{
+		MS_TRACE();
+
+		this->mapUnboundConnectionTimes[connection] = DepLibUV::GetTime();
+
+		if (!this->unboundTimer->IsActive())
+			this->unboundTimer->Start(UnboundConnectionCheckInterval, UnboundConnectionCheckInterval);
+	}
+
+	inline void SharedTcpServer::OnRtcTcpConnectionClosed(
+	  RTC::TcpServer* tcpServer, RTC::TcpConnection* connection)
+	{
+		MS_TRACE();
+
+		this->mapUnboundConnectionTimes.erase(connection);
+
+		auto it = this->mapConnectionListeners.find(connection);
+
+		if (it == this->mapConnectionListeners.end())
+			return;
+
+		auto* listener = it->second.listener;
+
+		this->mapConnectionListeners.erase(it);
+
+		listener->OnRtcTcpConnectionClosed(tcpServer, connection);
+	}
+
+	inline void SharedTcpServer::OnTcpConnectionPacketReceived(
+	  RTC::TcpConnection* connection, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		auto it = this->mapConnectionListeners.find(connection);
+
+		if (it != this->mapConnectionListeners.end())
+		{
+			it->second.connListener->OnTcpConnectionPacketReceived(connection, data, len);
+
+			return;
+		}
+
+		// Not yet bound connection, the first frame must be a STUN Binding Request.
+		if (!RTC::StunPacket::IsStun(data, len))
+		{
+			MS_DEBUG_TAG(ice, "non STUN packet in a not yet bound ICE-TCP connection, closing it");
+
+			RejectConnection(connection);
+
+			return;
+		}
+
+		RTC::StunPacket* packet = RTC::StunPacket::Parse(data, len);
+
+		if (packet == nullptr || packet->GetClass() != RTC::StunPacket::Class::REQUEST)
+		{
+			MS_DEBUG_TAG(ice, "invalid STUN packet in a not yet bound ICE-TCP connection, closing it");
+
+			delete packet;
+
+			RejectConnection(connection);
+
+			return;
+		}
+
+		// USERNAME is "localUsernameFragment:remoteUsernameFragment".
+		auto& username  = packet->GetUsername();
+		auto colonPos   = username.find(':');
+		auto listenerIt = this->mapUsernameFragmentListeners.find(username.substr(0, colonPos));
+
+		delete packet;
+
+		if (listenerIt == this->mapUsernameFragmentListeners.end())
+		{
+			MS_DEBUG_TAG(ice, "STUN Binding Request with unknown USERNAME, closing the connection");
+
+			RejectConnection(connection);
+
+			return;
+		}
+
+		this->mapUnboundConnectionTimes.erase(connection);
+		this->mapConnectionListeners[connection] = listenerIt->second;
+
+		listenerIt->second.connListener->OnTcpConnectionPacketReceived(connection, data, len);
+	}
+
+	inline void SharedTcpServer::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+		std::vector<RTC::TcpConnection*> connections;
+
+		for (auto& kv : this->mapUnboundConnectionTimes)
+		{
+			auto* connection = kv.first;
+
+			if (connection->IsClosed() || now - kv.second >= UnboundConnectionTimeout)
+				connections.push_back(connection);
+		}
+
+		// NOTE: This makes the TcpServer delete the connection (and it is removed
+		// from the map in OnRtcTcpConnectionClosed()).
+		for (auto* connection : connections)
+		{
+			MS_DEBUG_TAG(ice, "closing not bound ICE-TCP connection");
+
+			connection->ErrorReceiving();
+		}
+
+		if (this->mapUnboundConnectionTimes.empty())
+			this->unboundTimer->Stop();
+	}
+} // namespace RTC
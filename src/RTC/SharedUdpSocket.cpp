@@ -0,0 +1,241 @@
+#define MS_CLASS "RTC::SharedUdpSocket"
+// #define MS_LOG_DEV
+
+#include "RTC/SharedUdpSocket.hpp"
+#include "Logger.hpp"
+#include "RTC/StunPacket.hpp"
+#include <cstring> // std::memcpy(), std::memcmp(), std::memset()
+
+namespace RTC
+{
+	/* Class variables. */
+
+	thread_local std::unordered_map<std::string, SharedUdpSocket*> SharedUdpSocket::mapIpSharedUdpSockets;
+
+	/* Class methods. */
+
+	SharedUdpSocket* SharedUdpSocket::Acquire(std::string& ip)
+	{
+		MS_TRACE();
+
+		SharedUdpSocket* sharedUdpSocket;
+		auto it = SharedUdpSocket::mapIpSharedUdpSockets.find(ip);
+
+		if (it != SharedUdpSocket::mapIpSharedUdpSockets.end())
+		{
+			sharedUdpSocket = it->second;
+		}
+		else
+		{
+			// This may throw.
+			sharedUdpSocket = new SharedUdpSocket(ip);
+
+			SharedUdpSocket::mapIpSharedUdpSockets[ip] = sharedUdpSocket;
+		}
+
+		++sharedUdpSocket->refCount;
+
+		return sharedUdpSocket;
+	}
+
+	void SharedUdpSocket::Release(SharedUdpSocket* sharedUdpSocket)
+	{
+		MS_TRACE();
+
+		if (--sharedUdpSocket->refCount != 0)
+			return;
+
+		SharedUdpSocket::mapIpSharedUdpSockets.erase(sharedUdpSocket->ip);
+
+		delete sharedUdpSocket;
+	}
+
+	SharedUdpSocket::AddressKey SharedUdpSocket::GetAddressKey(const struct sockaddr* addr)
+	{
+		AddressKey key;
+
+		std::memset(&key, 0, sizeof(key));
+
+		key.family = static_cast<uint8_t>(addr->sa_family);
+
+		switch (addr->sa_family)
+		{
+			case AF_INET:
+			{
+				auto* addr4 = reinterpret_cast<const struct sockaddr_in*>(addr);
+
+				std::memcpy(key.ip, &addr4->sin_addr, sizeof(addr4->sin_addr));
+				key.port = addr4->sin_port;
+
+				break;
+			}
+
+			case AF_INET6:
+			{
+				auto* addr6 = reinterpret_cast<const struct sockaddr_in6*>(addr);
+
+				std::memcpy(key.ip, &addr6->sin6_addr, sizeof(addr6->sin6_addr));
+				key.port = addr6->sin6_port;
+
+				break;
+			}
+		}
+
+		return key;
+	}
+
+	/* Instance methods. */
+
+	inline bool SharedUdpSocket::AddressKey::operator==(const AddressKey& other) const
+	{
+		return (
+		  this->family == other.family && this->port == other.port &&
+		  std::memcmp(this->ip, other.ip, sizeof(this->ip)) == 0);
+	}
+
+	inline size_t SharedUdpSocket::AddressKeyHash::operator()(const AddressKey& key) const
+	{
+		// FNV-1a over the IP bytes, then mix the port and family.
+		uint64_t hash{ 14695981039346656037ULL };
+
+		for (auto byte : key.ip)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ULL;
+		}
+
+		hash ^= (uint64_t{ key.port } << 8) | key.family;
+		hash *= 1099511628211ULL;
+
+		return static_cast<size_t>(hash);
+	}
+
+	SharedUdpSocket::SharedUdpSocket(std::string& ip)
+	{
+		MS_TRACE();
+
+		// This may throw.
+		this->udpSocket = new RTC::UdpSocket(this, ip);
+
+		// Store the normalized IP.
+		this->ip = ip;
+	}
+
+	SharedUdpSocket::~SharedUdpSocket()
+	{
+		MS_TRACE();
+
+		delete this->udpSocket;
+	}
+
+	void SharedUdpSocket::AddUsernameFragment(
+	  const std::string& usernameFragment, RTC::UdpSocket::Listener* listener)
+	{
+		MS_TRACE();
+
+		this->mapUsernameFragmentListener[usernameFragment] = listener;
+		this->mapListenerKeys[listener].usernameFragments.push_back(usernameFragment);
+	}
+
+	/**
+	 * Packets from the remote address of the given tuple are given to the
+	 * listener from now on. It must be called once the tuple is authenticated.
+	 */
+	void SharedUdpSocket::AddRemoteAddress(
+	  const RTC::TransportTuple* tuple, RTC::UdpSocket::Listener* listener)
+	{
+		MS_TRACE();
+
+		RTC::TransportTuple sharedTuple(this->udpSocket, tuple->GetRemoteAddress());
+
+		// Not a tuple of this socket.
+		if (!sharedTuple.Compare(tuple))
+			return;
+
+		AddressKey key = SharedUdpSocket::GetAddressKey(tuple->GetRemoteAddress());
+
+		this->mapAddressListener[key] = listener;
+		this->mapListenerKeys[listener].addresses.push_back(key);
+	}
+
+	void SharedUdpSocket::RemoveListener(RTC::UdpSocket::Listener* listener)
+	{
+		MS_TRACE();
+
+		auto listenerIt = this->mapListenerKeys.find(listener);
+
+		if (listenerIt == this->mapListenerKeys.end())
+			return;
+
+		// NOTE: Entries may have been taken over by another listener meanwhile.
+		for (auto& usernameFragment : listenerIt->second.usernameFragments)
+		{
+			auto it = this->mapUsernameFragmentListener.find(usernameFragment);
+
+			if (it != this->mapUsernameFragmentListener.end() && it->second == listener)
+				this->mapUsernameFragmentListener.erase(it);
+		}
+
+		for (auto& key : listenerIt->second.addresses)
+		{
+			auto it = this->mapAddressListener.find(key);
+
+			if (it != this->mapAddressListener.end() && it->second == listener)
+				this->mapAddressListener.erase(it);
+		}
+
+		this->mapListenerKeys.erase(listenerIt);
+	}
+
+	inline void SharedUdpSocket::OnUdpSocketPacketReceived(
+	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	{
+		MS_TRACE();
+
+		AddressKey key = SharedUdpSocket::GetAddressKey(remoteAddr);
+
+		// STUN Binding Requests are always routed by USERNAME so a remote address
+		// reused by another transport (or by the same peer after an ICE restart)
+		// gets to the right one.
+		if (RTC::StunPacket::IsStun(data, len))
+		{
+			RTC::StunPacket* packet = RTC::StunPacket::Parse(data, len);
+
+			if (packet != nullptr && packet->GetClass() == RTC::StunPacket::Class::REQUEST)
+			{
+				// USERNAME is "localUsernameFragment:remoteUsernameFragment".
+				auto& username = packet->GetUsername();
+				auto colonPos  = username.find(':');
+				auto it        = this->mapUsernameFragmentListener.find(username.substr(0, colonPos));
+
+				delete packet;
+
+				if (it == this->mapUsernameFragmentListener.end())
+				{
+					MS_DEBUG_TAG(ice, "ignoring STUN Binding Request with unknown USERNAME");
+
+					return;
+				}
+
+				// NOTE: The remote address is mapped by the transport once its
+				// IceServer authenticates the request.
+				it->second->OnUdpSocketPacketReceived(socket, data, len, remoteAddr);
+
+				return;
+			}
+
+			delete packet;
+		}
+
+		auto it = this->mapAddressListener.find(key);
+
+		if (it == this->mapAddressListener.end())
+		{
+			MS_DEBUG_DEV("ignoring packet from unknown remote address");
+
+			return;
+		}
+
+		it->second->OnUdpSocketPacketReceived(socket, data, len, remoteAddr);
+	}
+} // namespace RTC
@@ -154,6 +154,9 @@ namespace RTC
 			return;
 		}
 
+		// Undo the payload rewrite left by a previous Consumer of the same packet.
+		packet->RestorePayload();
+
 		// If we need to sync, support key frames and this is not a key frame, ignore
 		// the packet.
 		if (this->syncRequired && this->keyFrameSupported && !packet->IsKeyFrame())
@@ -178,13 +181,10 @@ namespace RTC
 
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
-		// Save original packet fields.
-		auto origSsrc = packet->GetSsrc();
-		auto origSeq  = packet->GetSequenceNumber();
-
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
+		// Build the packet to send with the rewritten header. The original packet,
+		// which may be shared with other Consumers, is not modified.
+		RTC::EgressRtpPacket egressPacket(
+		  packet, this->rtpParameters.encodings[0].ssrc, seq, packet->GetTimestamp());
 
 		if (isSyncPacket)
 		{
@@ -192,17 +192,17 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq);
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
+			  packet->GetSequenceNumber());
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		if (this->rtpStream->ReceivePacket(egressPacket))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, egressPacket);
 		}
 		else
 		{
@@ -210,15 +210,11 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq);
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
+			  packet->GetSequenceNumber());
 		}
-
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
 	}
 
 	void SimpleConsumer::SendProbationRtpPacket(uint16_t seq)
@@ -853,15 +853,10 @@ namespace RTC
 
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
-		// Save original packet fields.
-		auto origSsrc      = packet->GetSsrc();
-		auto origSeq       = packet->GetSequenceNumber();
-		auto origTimestamp = packet->GetTimestamp();
-
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
-		packet->SetTimestamp(timestamp);
+		// Build the packet to send with the rewritten header. The original packet,
+		// which may be shared with other Consumers, is not modified.
+		RTC::EgressRtpPacket egressPacket(
+		  packet, this->rtpParameters.encodings[0].ssrc, seq, timestamp);
 
 		if (isSyncPacket)
 		{
@@ -869,19 +864,19 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32 "]",
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
 			  packet->GetSsrc(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSsrc,
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		if (this->rtpStream->ReceivePacket(egressPacket))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, egressPacket);
 		}
 		else
 		{
@@ -889,21 +884,13 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32 "]",
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
 			  packet->GetSsrc(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSsrc,
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
-
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-		packet->SetTimestamp(origTimestamp);
-
-		// Restore the original payload if needed.
-		packet->RestorePayload();
 	}
 
 	void SimulcastConsumer::SendProbationRtpPacket(uint16_t seq)
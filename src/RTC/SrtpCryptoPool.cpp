@@ -0,0 +1,241 @@
+#define MS_CLASS "RTC::SrtpCryptoPool"
+// #define MS_LOG_DEV
+
+#include "RTC/SrtpCryptoPool.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t BatchesQueueSize{ 64 };
+	static constexpr size_t MessagesQueueSize{ 1024 };
+
+	/* Static methods for UV callbacks. */
+
+	inline static void onAsync(uv_async_t* handle)
+	{
+		static_cast<SrtpCryptoPool*>(handle->data)->OnUvBatchesDone();
+	}
+
+	inline static void onClose(uv_handle_t* handle)
+	{
+		delete handle;
+	}
+
+	/* Instance methods. */
+
+	SrtpCryptoPool::SrtpCryptoPool(size_t numThreads, BatchDoneCallback callback)
+	  : callback(callback)
+	{
+		MS_TRACE();
+
+		this->uvHandle       = new uv_async_t;
+		this->uvHandle->data = (void*)this;
+
+		int err =
+		  uv_async_init(DepLibUV::GetLoop(), this->uvHandle, static_cast<uv_async_cb>(onAsync));
+
+		if (err != 0)
+		{
+			delete this->uvHandle;
+			this->uvHandle = nullptr;
+
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+		}
+
+		// It must not keep the loop alive.
+		uv_unref(reinterpret_cast<uv_handle_t*>(this->uvHandle));
+
+		try
+		{
+			for (size_t idx{ 0 }; idx < numThreads; ++idx)
+			{
+				this->threads.push_back(new CryptoThread(this));
+			}
+		}
+		catch (const MediaSoupError& /*error*/)
+		{
+			for (auto* thread : this->threads)
+			{
+				delete thread;
+			}
+			this->threads.clear();
+
+			uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+
+			throw;
+		}
+	}
+
+	SrtpCryptoPool::~SrtpCryptoPool()
+	{
+		MS_TRACE();
+
+		// Hand back the remaining batches.
+		Wait();
+		OnUvBatchesDone();
+
+		for (auto* thread : this->threads)
+		{
+			delete thread;
+		}
+		this->threads.clear();
+
+		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+	}
+
+	void SrtpCryptoPool::Submit(Batch* batch, size_t threadIdx)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(threadIdx < this->threads.size(), "invalid thread index");
+
+		batch->done.store(false, std::memory_order_relaxed);
+
+		this->pendingBatches.push_back(batch);
+		this->threads[threadIdx]->Submit(batch);
+	}
+
+	/**
+	 * Blocks until all the submitted batches have been processed. They are
+	 * handed back later as usual.
+	 */
+	void SrtpCryptoPool::Wait() const
+	{
+		MS_TRACE();
+
+		std::unique_lock<std::mutex> lock(this->doneMutex);
+
+		for (auto* batch : this->pendingBatches)
+		{
+			this->doneCond.wait(
+			  lock, [batch]() { return batch->done.load(std::memory_order_acquire); });
+		}
+	}
+
+	/**
+	 * Called from the pool threads.
+	 */
+	inline void SrtpCryptoPool::NotifyLoop()
+	{
+		uv_async_send(this->uvHandle);
+	}
+
+	/**
+	 * Called from the pool threads. The flag is set under the mutex so Wait()
+	 * cannot miss the signal.
+	 */
+	inline void SrtpCryptoPool::SetBatchDone(Batch* batch)
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->doneMutex);
+
+			batch->done.store(true, std::memory_order_release);
+		}
+
+		this->doneCond.notify_all();
+	}
+
+	void SrtpCryptoPool::OnUvBatchesDone()
+	{
+		MS_TRACE();
+
+		for (auto* thread : this->threads)
+		{
+			thread->DeliverMessages();
+		}
+
+		// A batch processed before an older one must wait for it.
+		while (!this->pendingBatches.empty())
+		{
+			auto* batch = this->pendingBatches.front();
+
+			if (!batch->done.load(std::memory_order_acquire))
+				break;
+
+			this->pendingBatches.pop_front();
+
+			// May submit new batches.
+			this->callback(batch);
+		}
+	}
+
+	/* Instance methods of CryptoThread. */
+
+	// NOTE: Messages are dropped if the loop does not keep up since the thread
+	// must not block (the loop may be waiting for it).
+	SrtpCryptoPool::CryptoThread::CryptoThread(SrtpCryptoPool* pool)
+	  : ChannelThread(Logger::channel, MessagesQueueSize, ChannelThread::QueueFullPolicy::DROP),
+	    pool(pool), batches(BatchesQueueSize)
+	{
+		MS_TRACE();
+
+		uv_sem_init(&this->sem, 0);
+
+		try
+		{
+			Start();
+		}
+		catch (const MediaSoupError& /*error*/)
+		{
+			uv_sem_destroy(&this->sem);
+
+			throw;
+		}
+	}
+
+	SrtpCryptoPool::CryptoThread::~CryptoThread()
+	{
+		MS_TRACE();
+
+		this->stopping.store(true);
+		uv_sem_post(&this->sem);
+		Join();
+		uv_sem_destroy(&this->sem);
+	}
+
+	/**
+	 * Called from the loop thread.
+	 */
+	void SrtpCryptoPool::CryptoThread::Submit(Batch* batch)
+	{
+		MS_TRACE();
+
+		// The thread always drains the queue so it will have room soon.
+		this->batches.PushWait(std::move(batch));
+
+		uv_sem_post(&this->sem);
+	}
+
+	void SrtpCryptoPool::CryptoThread::UserOnThread()
+	{
+		while (true)
+		{
+			uv_sem_wait(&this->sem);
+
+			Batch* batch;
+
+			while (this->batches.Pop(batch))
+			{
+				RTC::SrtpSession::ProcessRtpBatch(batch->items.data(), batch->count);
+
+				this->pool->SetBatchDone(batch);
+				this->pool->NotifyLoop();
+			}
+
+			if (this->stopping.load())
+				break;
+		}
+	}
+
+	/**
+	 * Called from the thread.
+	 */
+	void SrtpCryptoPool::CryptoThread::NotifyLoop()
+	{
+		this->pool->NotifyLoop();
+	}
+} // namespace RTC
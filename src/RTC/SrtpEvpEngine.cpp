@@ -0,0 +1,410 @@
+#define MS_CLASS "RTC::SrtpEvpEngine"
+// #define MS_LOG_DEV
+
+#include "RTC/SrtpEvpEngine.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy(), std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Key derivation labels (RFC 3711 section 4.3.2).
+	static constexpr uint8_t LabelRtpEncryption{ 0x00 };
+	static constexpr uint8_t LabelRtpAuthentication{ 0x01 };
+	static constexpr uint8_t LabelRtpSalt{ 0x02 };
+	static constexpr size_t AuthKeyLen{ 20 };
+	static constexpr size_t AesCmSaltLen{ 14 };
+	static constexpr size_t AesGcmSaltLen{ 12 };
+	static constexpr size_t AesGcmTagLen{ 16 };
+	static constexpr size_t ShaBlockLen{ 64 };
+	// Same replay window as the libsrtp session (packets older than this are
+	// not protected).
+	static constexpr int32_t ReplayWindowSize{ 1024 };
+	static uint8_t ZeroBuffer[64];
+
+	/* Instance methods. */
+
+	SrtpEvpEngine::SrtpEvpEngine(RTC::SrtpSession::Profile profile, const uint8_t* key, size_t keyLen)
+	{
+		MS_TRACE();
+
+		const EVP_CIPHER* prfCipher;
+		const EVP_CIPHER* cipher;
+		size_t masterKeyLen;
+		size_t saltLen;
+
+		switch (profile)
+		{
+			case RTC::SrtpSession::Profile::AES_CM_128_HMAC_SHA1_80:
+			case RTC::SrtpSession::Profile::AES_CM_128_HMAC_SHA1_32:
+			{
+				prfCipher    = EVP_aes_128_ctr();
+				cipher       = EVP_aes_128_ctr();
+				masterKeyLen = 16;
+				saltLen      = AesCmSaltLen;
+				this->tagLen =
+				  profile == RTC::SrtpSession::Profile::AES_CM_128_HMAC_SHA1_80 ? 10 : 4;
+
+				break;
+			}
+
+			case RTC::SrtpSession::Profile::AEAD_AES_128_GCM:
+			{
+				prfCipher    = EVP_aes_128_ctr();
+				cipher       = EVP_aes_128_gcm();
+				masterKeyLen = 16;
+				saltLen      = AesGcmSaltLen;
+				this->aead   = true;
+				this->tagLen = AesGcmTagLen;
+
+				break;
+			}
+
+			case RTC::SrtpSession::Profile::AEAD_AES_256_GCM:
+			{
+				prfCipher    = EVP_aes_256_ctr();
+				cipher       = EVP_aes_256_gcm();
+				masterKeyLen = 32;
+				saltLen      = AesGcmSaltLen;
+				this->aead   = true;
+				this->tagLen = AesGcmTagLen;
+
+				break;
+			}
+
+			default:
+			{
+				MS_THROW_ERROR("unsupported SRTP profile");
+			}
+		}
+
+		if (keyLen != masterKeyLen + saltLen)
+			MS_THROW_ERROR("wrong key length [keyLen:%zu]", keyLen);
+
+		/* Derive the session keys. */
+
+		uint8_t sessionKey[32];
+		uint8_t authKey[AuthKeyLen];
+
+		DeriveSessionKey(
+		  prfCipher, key, key + masterKeyLen, saltLen, LabelRtpEncryption, sessionKey, masterKeyLen);
+		DeriveSessionKey(
+		  prfCipher, key, key + masterKeyLen, saltLen, LabelRtpSalt, this->sessionSalt, saltLen);
+
+		/* Expand the cipher key once. */
+
+		this->cipherCtx = EVP_CIPHER_CTX_new();
+
+		if (!this->cipherCtx)
+			MS_THROW_ERROR("EVP_CIPHER_CTX_new() failed");
+
+		if (EVP_EncryptInit_ex(this->cipherCtx, cipher, nullptr, sessionKey, nullptr) != 1)
+		{
+			EVP_CIPHER_CTX_free(this->cipherCtx);
+
+			MS_THROW_ERROR("EVP_EncryptInit_ex() failed");
+		}
+
+		std::memset(sessionKey, 0, sizeof(sessionKey));
+
+		if (this->aead)
+			return;
+
+		/* Hash the HMAC-SHA1 key pads. */
+
+		uint8_t pad[ShaBlockLen];
+
+		DeriveSessionKey(
+		  prfCipher, key, key + masterKeyLen, saltLen, LabelRtpAuthentication, authKey, AuthKeyLen);
+
+		std::memset(pad, 0x36, ShaBlockLen);
+
+		for (size_t i{ 0 }; i < AuthKeyLen; ++i)
+		{
+			pad[i] ^= authKey[i];
+		}
+
+		SHA1_Init(&this->authInnerCtx);
+		SHA1_Update(&this->authInnerCtx, pad, ShaBlockLen);
+
+		std::memset(pad, 0x5c, ShaBlockLen);
+
+		for (size_t i{ 0 }; i < AuthKeyLen; ++i)
+		{
+			pad[i] ^= authKey[i];
+		}
+
+		SHA1_Init(&this->authOuterCtx);
+		SHA1_Update(&this->authOuterCtx, pad, ShaBlockLen);
+
+		std::memset(authKey, 0, sizeof(authKey));
+		std::memset(pad, 0, sizeof(pad));
+	}
+
+	SrtpEvpEngine::~SrtpEvpEngine()
+	{
+		MS_TRACE();
+
+		EVP_CIPHER_CTX_free(this->cipherCtx);
+	}
+
+	// NOTE: The caller must ensure that the given memory has space enough after
+	// the packet for the authentication tag.
+	bool SrtpEvpEngine::EncryptRtp(uint8_t* data, size_t* len)
+	{
+		MS_TRACE();
+
+		if (*len < 12)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, too small (%zu bytes)", *len);
+
+			return false;
+		}
+
+		// Header length including CSRCs and header extension.
+		size_t headerLen = 12 + (4 * static_cast<size_t>(data[0] & 0x0F));
+
+		if ((data[0] & 0x10) != 0)
+		{
+			if (headerLen + 4 > *len)
+			{
+				MS_WARN_TAG(srtp, "cannot encrypt RTP packet, wrong header extension");
+
+				return false;
+			}
+
+			headerLen += 4 + (4 * static_cast<size_t>(Utils::Byte::Get2Bytes(data, headerLen + 2)));
+		}
+
+		if (headerLen > *len)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, wrong header length");
+
+			return false;
+		}
+
+		auto seq  = Utils::Byte::Get2Bytes(data, 2);
+		auto ssrc = Utils::Byte::Get4Bytes(data, 8);
+		uint64_t index;
+
+		if (!GetPacketIndex(ssrc, seq, index))
+		{
+			MS_WARN_TAG(
+			  srtp,
+			  "cannot encrypt RTP packet, too old [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
+			  ssrc,
+			  seq);
+
+			return false;
+		}
+
+		if (this->aead)
+			return EncryptRtpAesGcm(data, headerLen, len, index);
+		else
+			return EncryptRtpAesCm(data, headerLen, len, index);
+	}
+
+	void SrtpEvpEngine::RemoveStream(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		this->mapSsrcPacketIndex.erase(ssrc);
+	}
+
+	/**
+	 * AES-CM PRF (RFC 3711 section 4.3.3) with a key derivation rate of 0.
+	 */
+	void SrtpEvpEngine::DeriveSessionKey(
+	  const EVP_CIPHER* prfCipher,
+	  const uint8_t* masterKey,
+	  const uint8_t* masterSalt,
+	  size_t masterSaltLen,
+	  uint8_t label,
+	  uint8_t* sessionKey,
+	  size_t sessionKeyLen)
+	{
+		MS_TRACE();
+
+		uint8_t iv[16] = { 0 };
+		int outLen;
+
+		// A 96 bits master salt (AEAD) is padded with zeroes.
+		std::memcpy(iv, masterSalt, masterSaltLen);
+		iv[7] ^= label;
+
+		auto* ctx = EVP_CIPHER_CTX_new();
+
+		// clang-format off
+		if (
+			!ctx ||
+			EVP_EncryptInit_ex(ctx, prfCipher, nullptr, masterKey, iv) != 1 ||
+			EVP_EncryptUpdate(ctx, sessionKey, &outLen, ZeroBuffer, static_cast<int>(sessionKeyLen)) != 1
+		)
+		// clang-format on
+		{
+			EVP_CIPHER_CTX_free(ctx);
+
+			MS_THROW_ERROR("SRTP key derivation failed");
+		}
+
+		EVP_CIPHER_CTX_free(ctx);
+	}
+
+	/**
+	 * Estimates the packet index (ROC and seq) the same way libsrtp does and
+	 * records it as the highest one if newer.
+	 */
+	bool SrtpEvpEngine::GetPacketIndex(uint32_t ssrc, uint16_t seq, uint64_t& index)
+	{
+		MS_TRACE();
+
+		auto& highestIndex = this->mapSsrcPacketIndex[ssrc];
+		int32_t delta;
+
+		if (highestIndex <= 0x8000)
+		{
+			index = seq;
+			delta = static_cast<int32_t>(seq) - static_cast<int32_t>(highestIndex);
+		}
+		else
+		{
+			auto localRoc = static_cast<uint32_t>(highestIndex >> 16);
+			auto localSeq = static_cast<int32_t>(highestIndex & 0xFFFF);
+			uint32_t roc;
+
+			delta = static_cast<int32_t>(seq) - localSeq;
+
+			if (localSeq < 0x8000 && delta > 0x8000)
+			{
+				roc = localRoc - 1;
+				delta -= 0x10000;
+			}
+			else if (localSeq >= 0x8000 && localSeq - 0x8000 > static_cast<int32_t>(seq))
+			{
+				roc = localRoc + 1;
+				delta += 0x10000;
+			}
+			else
+			{
+				roc = localRoc;
+			}
+
+			index = (static_cast<uint64_t>(roc) << 16) | seq;
+		}
+
+		if (delta > 0)
+			highestIndex = index;
+		else if (delta < -(ReplayWindowSize - 1))
+			return false;
+
+		return true;
+	}
+
+	bool SrtpEvpEngine::EncryptRtpAesCm(uint8_t* data, size_t headerLen, size_t* len, uint64_t index)
+	{
+		MS_TRACE();
+
+		// IV = (salt * 2^16) XOR (SSRC * 2^64) XOR (index * 2^16).
+		uint8_t iv[16] = { 0 };
+		auto roc       = static_cast<uint32_t>(index >> 16);
+		uint8_t rocBytes[4];
+		uint8_t digest[SHA_DIGEST_LENGTH];
+		int outLen;
+
+		std::memcpy(iv, this->sessionSalt, AesCmSaltLen);
+
+		for (size_t i{ 0 }; i < 4; ++i)
+		{
+			iv[4 + i] ^= data[8 + i];
+		}
+
+		for (size_t i{ 0 }; i < 6; ++i)
+		{
+			iv[8 + i] ^= static_cast<uint8_t>(index >> (8 * (5 - i)));
+		}
+
+		// clang-format off
+		if (
+			EVP_EncryptInit_ex(this->cipherCtx, nullptr, nullptr, nullptr, iv) != 1 ||
+			EVP_EncryptUpdate(
+				this->cipherCtx,
+				data + headerLen,
+				&outLen,
+				data + headerLen,
+				static_cast<int>(*len - headerLen)) != 1
+		)
+		// clang-format on
+		{
+			MS_WARN_TAG(srtp, "EVP_EncryptUpdate() failed");
+
+			return false;
+		}
+
+		// Authentication tag = HMAC-SHA1(packet || ROC).
+		SHA_CTX ctx = this->authInnerCtx;
+
+		Utils::Byte::Set4Bytes(rocBytes, 0, roc);
+
+		SHA1_Update(&ctx, data, *len);
+		SHA1_Update(&ctx, rocBytes, sizeof(rocBytes));
+		SHA1_Final(digest, &ctx);
+
+		ctx = this->authOuterCtx;
+
+		SHA1_Update(&ctx, digest, sizeof(digest));
+		SHA1_Final(digest, &ctx);
+
+		std::memcpy(data + *len, digest, this->tagLen);
+
+		*len += this->tagLen;
+
+		return true;
+	}
+
+	bool SrtpEvpEngine::EncryptRtpAesGcm(uint8_t* data, size_t headerLen, size_t* len, uint64_t index)
+	{
+		MS_TRACE();
+
+		// IV = (00 00 || SSRC || ROC || SEQ) XOR salt (RFC 7714 section 8.1).
+		uint8_t iv[AesGcmSaltLen] = { 0 };
+		int outLen;
+
+		std::memcpy(iv + 2, data + 8, 4);
+		Utils::Byte::Set4Bytes(iv, 6, static_cast<uint32_t>(index >> 16));
+		Utils::Byte::Set2Bytes(iv, 10, static_cast<uint16_t>(index));
+
+		for (size_t i{ 0 }; i < AesGcmSaltLen; ++i)
+		{
+			iv[i] ^= this->sessionSalt[i];
+		}
+
+		// The header is the AAD and the payload is encrypted in place.
+		// clang-format off
+		if (
+			EVP_EncryptInit_ex(this->cipherCtx, nullptr, nullptr, nullptr, iv) != 1 ||
+			EVP_EncryptUpdate(this->cipherCtx, nullptr, &outLen, data, static_cast<int>(headerLen)) != 1 ||
+			EVP_EncryptUpdate(
+				this->cipherCtx,
+				data + headerLen,
+				&outLen,
+				data + headerLen,
+				static_cast<int>(*len - headerLen)) != 1 ||
+			EVP_EncryptFinal_ex(this->cipherCtx, data + *len, &outLen) != 1 ||
+			EVP_CIPHER_CTX_ctrl(
+				this->cipherCtx, EVP_CTRL_GCM_GET_TAG, static_cast<int>(this->tagLen), data + *len) != 1
+		)
+		// clang-format on
+		{
+			MS_WARN_TAG(srtp, "AES-GCM encryption failed");
+
+			return false;
+		}
+
+		*len += this->tagLen;
+
+		return true;
+	}
+} // namespace RTC
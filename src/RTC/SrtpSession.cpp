@@ -5,6 +5,9 @@
 #include "DepLibSRTP.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include "Utils.hpp"
+#include "RTC/SrtpEvpEngine.hpp"
 #include <cstring> // std::memset(), std::memcpy()
 
 namespace RTC
@@ -12,7 +15,7 @@ namespace RTC
 	/* Static. */
 
 	static constexpr size_t EncryptBufferSize{ 65536 };
-	static uint8_t EncryptBuffer[EncryptBufferSize];
+	static thread_local uint8_t EncryptBuffer[EncryptBufferSize];
 
 	/* Class methods. */
 
@@ -28,6 +31,27 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Encrypts or decrypts in place all the packets of the given items back to
+	 * back.
+	 */
+	void SrtpSession::ProcessRtpBatch(RtpBatchItem* items, size_t count)
+	{
+		MS_TRACE();
+
+		for (size_t idx{ 0 }; idx < count; ++idx)
+		{
+			auto& item = items[idx];
+
+			if (!item.session)
+				item.processed = false;
+			else if (item.type == Type::OUTBOUND)
+				item.processed = item.session->EncryptRtpInPlace(item.data, &item.len);
+			else
+				item.processed = item.session->DecryptSrtp(item.data, &item.len);
+		}
+	}
+
 	void SrtpSession::OnSrtpEvent(srtp_event_data_t* data)
 	{
 		MS_TRACE();
@@ -58,7 +82,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		srtp_policy_t policy; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		auto& policy = this->policy;
 
 		// Set all policy fields to 0.
 		std::memset(&policy, 0, sizeof(srtp_policy_t));
@@ -107,6 +131,10 @@ namespace RTC
 		MS_ASSERT(
 		  (int)keyLen == policy.rtp.cipher_key_len,
 		  "given keyLen does not match policy.rtp.cipher_keyLen");
+		MS_ASSERT(keyLen <= sizeof(this->key), "keyLen too big");
+
+		// Keep a copy of the key to create per SSRC sessions later.
+		std::memcpy(this->key, key, keyLen);
 
 		switch (type)
 		{
@@ -120,7 +148,7 @@ namespace RTC
 		}
 
 		policy.ssrc.value = 0;
-		policy.key        = key;
+		policy.key        = this->key;
 		// Required for sending RTP retransmission without RTX.
 		policy.allow_repeat_tx = 1;
 		policy.window_size     = 1024;
@@ -131,12 +159,28 @@ namespace RTC
 
 		if (DepLibSRTP::IsError(err))
 			MS_THROW_ERROR("srtp_create() failed: %s", DepLibSRTP::GetErrorString(err));
+
+		// Use the native engine for outgoing RTP if requested. libsrtp keeps
+		// handling RTCP.
+		if (type == Type::OUTBOUND && Settings::configuration.nativeSrtp)
+		{
+			try
+			{
+				this->evpEngine = new RTC::SrtpEvpEngine(profile, key, keyLen);
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_WARN_TAG(srtp, "native SRTP engine not available, using libsrtp: %s", error.what());
+			}
+		}
 	}
 
 	SrtpSession::~SrtpSession()
 	{
 		MS_TRACE();
 
+		delete this->evpEngine;
+
 		if (this->session != nullptr)
 		{
 			srtp_err_status_t err = srtp_dealloc(this->session);
@@ -144,6 +188,17 @@ namespace RTC
 			if (DepLibSRTP::IsError(err))
 				MS_ABORT("srtp_dealloc() failed: %s", DepLibSRTP::GetErrorString(err));
 		}
+
+		for (auto& kv : this->mapSsrcSession)
+		{
+			auto* session = kv.second;
+
+			srtp_err_status_t err = srtp_dealloc(session);
+
+			if (DepLibSRTP::IsError(err))
+				MS_ABORT("srtp_dealloc() failed: %s", DepLibSRTP::GetErrorString(err));
+		}
+		this->mapSsrcSession.clear();
 	}
 
 	bool SrtpSession::EncryptRtp(const uint8_t** data, size_t* len)
@@ -160,8 +215,41 @@ namespace RTC
 
 		std::memcpy(EncryptBuffer, *data, *len);
 
-		srtp_err_status_t err =
-		  srtp_protect(this->session, (void*)EncryptBuffer, reinterpret_cast<int*>(len));
+		if (!EncryptRtpInPlace(EncryptBuffer, len))
+			return false;
+
+		// Update the given data pointer.
+		*data = (const uint8_t*)EncryptBuffer;
+
+		return true;
+	}
+
+	// NOTE: The caller must ensure that the given memory has SRTP_MAX_TRAILER_LEN
+	// bytes of space after the packet.
+	bool SrtpSession::EncryptRtpInPlace(uint8_t* data, size_t* len)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (this->evpEngine)
+			return this->evpEngine->EncryptRtp(data, len);
+
+		if (*len < 12)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, too small (%zu bytes)", *len);
+
+			return false;
+		}
+
+		auto ssrc     = Utils::Byte::Get4Bytes(data, 8);
+		auto* session = GetSession(ssrc);
+
+		// Outgoing streams get their session before their first packet.
+		if (session == this->session)
+			session = AddStreamSession(ssrc);
+
+		srtp_err_status_t err = srtp_protect(session, (void*)data, reinterpret_cast<int*>(len));
 
 		if (DepLibSRTP::IsError(err))
 		{
@@ -170,9 +258,6 @@ namespace RTC
 			return false;
 		}
 
-		// Update the given data pointer.
-		*data = (const uint8_t*)EncryptBuffer;
-
 		return true;
 	}
 
@@ -180,7 +265,19 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		srtp_err_status_t err = srtp_unprotect(this->session, (void*)data, reinterpret_cast<int*>(len));
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (*len < 12)
+		{
+			MS_DEBUG_TAG(srtp, "cannot decrypt SRTP packet, too small (%zu bytes)", *len);
+
+			return false;
+		}
+
+		auto ssrc     = Utils::Byte::Get4Bytes(data, 8);
+		auto* session = GetSession(ssrc);
+
+		srtp_err_status_t err = srtp_unprotect(session, (void*)data, reinterpret_cast<int*>(len));
 
 		if (DepLibSRTP::IsError(err))
 		{
@@ -189,6 +286,9 @@ namespace RTC
 			return false;
 		}
 
+		if (session == this->session)
+			AddStreamSession(ssrc);
+
 		return true;
 	}
 
@@ -204,10 +304,26 @@ namespace RTC
 			return false;
 		}
 
+		if (*len < 8)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTCP packet, too small (%zu bytes)", *len);
+
+			return false;
+		}
+
 		std::memcpy(EncryptBuffer, *data, *len);
 
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		auto ssrc     = Utils::Byte::Get4Bytes(EncryptBuffer, 4);
+		auto* session = GetSession(ssrc);
+
+		// Outgoing streams get their session before their first packet.
+		if (session == this->session)
+			session = AddStreamSession(ssrc);
+
 		srtp_err_status_t err =
-		  srtp_protect_rtcp(this->session, (void*)EncryptBuffer, reinterpret_cast<int*>(len));
+		  srtp_protect_rtcp(session, (void*)EncryptBuffer, reinterpret_cast<int*>(len));
 
 		if (DepLibSRTP::IsError(err))
 		{
@@ -226,8 +342,20 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (*len < 8)
+		{
+			MS_DEBUG_TAG(srtp, "cannot decrypt SRTCP packet, too small (%zu bytes)", *len);
+
+			return false;
+		}
+
+		auto ssrc     = Utils::Byte::Get4Bytes(data, 4);
+		auto* session = GetSession(ssrc);
+
 		srtp_err_status_t err =
-		  srtp_unprotect_rtcp(this->session, (void*)data, reinterpret_cast<int*>(len));
+		  srtp_unprotect_rtcp(session, (void*)data, reinterpret_cast<int*>(len));
 
 		if (DepLibSRTP::IsError(err))
 		{
@@ -236,6 +364,75 @@ namespace RTC
 			return false;
 		}
 
+		if (session == this->session)
+			AddStreamSession(ssrc);
+
 		return true;
 	}
+
+	void SrtpSession::RemoveStream(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		auto it = this->mapSsrcSession.find(ssrc);
+
+		if (it != this->mapSsrcSession.end())
+		{
+			auto* session = it->second;
+
+			srtp_dealloc(session);
+			this->mapSsrcSession.erase(it);
+		}
+		else
+		{
+			srtp_remove_stream(this->session, uint32_t{ htonl(ssrc) });
+		}
+
+		if (this->evpEngine)
+			this->evpEngine->RemoveStream(ssrc);
+	}
+
+	/**
+	 * Returns the libsrtp session holding the stream of the given SSRC, or the
+	 * main session (with the stream template) if there is none yet.
+	 */
+	inline srtp_t SrtpSession::GetSession(uint32_t ssrc) const
+	{
+		auto it = this->mapSsrcSession.find(ssrc);
+
+		if (it == this->mapSsrcSession.end())
+			return this->session;
+
+		return it->second;
+	}
+
+	/**
+	 * Creates a session for this SSRC so libsrtp never walks a long stream
+	 * list, and removes the stream libsrtp may have created for it in the main
+	 * session. Incoming streams are only moved once a packet has been
+	 * successfully authenticated, so bogus packets do not allocate sessions.
+	 * Returns the main session if the new one cannot be created.
+	 */
+	srtp_t SrtpSession::AddStreamSession(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		srtp_t session{ nullptr };
+		srtp_err_status_t err = srtp_create(&session, &this->policy);
+
+		if (DepLibSRTP::IsError(err))
+		{
+			MS_WARN_TAG(srtp, "srtp_create() failed: %s", DepLibSRTP::GetErrorString(err));
+
+			return this->session;
+		}
+
+		srtp_remove_stream(this->session, uint32_t{ htonl(ssrc) });
+
+		this->mapSsrcSession[ssrc] = session;
+
+		return session;
+	}
 } // namespace RTC
@@ -675,13 +675,10 @@ namespace RTC
 
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 
-		// Save original packet fields.
-		auto origSsrc = packet->GetSsrc();
-		auto origSeq  = packet->GetSequenceNumber();
-
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
+		// Build the packet to send with the rewritten header. The original packet,
+		// which may be shared with other Consumers, is not modified.
+		RTC::EgressRtpPacket egressPacket(
+		  packet, this->rtpParameters.encodings[0].ssrc, seq, packet->GetTimestamp());
 
 		if (isSyncPacket)
 		{
@@ -689,17 +686,17 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq);
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
+			  packet->GetSequenceNumber());
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		if (this->rtpStream->ReceivePacket(egressPacket))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, egressPacket);
 		}
 		else
 		{
@@ -707,19 +704,12 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
+			  egressPacket.GetSsrc(),
+			  egressPacket.GetSequenceNumber(),
+			  egressPacket.GetTimestamp(),
 			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSsrc,
-			  origSeq);
+			  packet->GetSequenceNumber());
 		}
-
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-
-		// Restore the original payload if needed.
-		packet->RestorePayload();
 	}
 
 	void SvcConsumer::SendProbationRtpPacket(uint16_t seq)
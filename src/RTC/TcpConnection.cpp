@@ -11,7 +11,9 @@ namespace RTC
 	/* Static. */
 
 	static constexpr size_t ReadBufferSize{ 65536 };
-	static uint8_t ReadBuffer[ReadBufferSize];
+	static thread_local uint8_t ReadBuffer[ReadBufferSize];
+	// Max size of the header given to the two-part Send().
+	static constexpr size_t MaxSendHeaderLen{ 64 };
 
 	/* Instance methods. */
 
@@ -168,4 +170,27 @@ namespace RTC
 		Utils::Byte::Set2Bytes(frameLen, 0, len);
 		::TcpConnection::Write(frameLen, 2, data, len);
 	}
+
+	/**
+	 * Sends a packet made of a small header and the rest of the packet without
+	 * assembling it first.
+	 */
+	void TcpConnection::Send(const uint8_t* header, size_t headerLen, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(headerLen <= MaxSendHeaderLen, "header too big");
+
+		// Update sent bytes.
+		this->sentBytes += headerLen + len;
+
+		// Write according to Framing RFC 4571, with the frame length and the
+		// header in the same buffer.
+
+		uint8_t frameHeader[2 + MaxSendHeaderLen];
+
+		Utils::Byte::Set2Bytes(frameHeader, 0, headerLen + len);
+		std::memcpy(frameHeader + 2, header, headerLen);
+		::TcpConnection::Write(frameHeader, 2 + headerLen, data, len);
+	}
 } // namespace RTC
@@ -8,16 +8,13 @@
 
 namespace RTC
 {
-	/* Static. */
-
-	static constexpr size_t MaxTcpConnectionsPerServer{ 10 };
-
 	/* Instance methods. */
 
-	TcpServer::TcpServer(Listener* listener, RTC::TcpConnection::Listener* connListener, std::string& ip)
+	TcpServer::TcpServer(
+	  Listener* listener, RTC::TcpConnection::Listener* connListener, std::string& ip, size_t maxConnections)
 	  : // This may throw.
 	    ::TcpServer::TcpServer(PortManager::BindTcp(ip), 256), listener(listener),
-	    connListener(connListener)
+	    connListener(connListener), maxConnections(maxConnections)
 	{
 		MS_TRACE();
 	}
@@ -41,13 +38,15 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		if (GetNumConnections() >= MaxTcpConnectionsPerServer)
+		if (GetNumConnections() >= this->maxConnections)
 		{
-			MS_ERROR("cannot handle more than %zu connections", MaxTcpConnectionsPerServer);
+			MS_ERROR("cannot handle more than %zu connections", this->maxConnections);
 
 			return false;
 		}
 
+		this->listener->OnRtcTcpConnectionAccepted(this, static_cast<RTC::TcpConnection*>(connection));
+
 		return true;
 	}
 
@@ -5,6 +5,7 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
 #include "Channel/Notifier.hpp"
 #include "RTC/PipeConsumer.hpp"
@@ -731,6 +732,10 @@ namespace RTC
 		)
 		// clang-format on
 		{
+			// usrsctp timers are global and run in the main loop.
+			if (Settings::configuration.workerThreads != 0)
+				MS_THROW_TYPE_ERROR("SCTP is not supported with workerThreads");
+
 			auto jsonNumSctpStreamsIt     = data.find("numSctpStreams");
 			auto jsonMaxSctpMessageSizeIt = data.find("maxSctpMessageSize");
 			auto jsonIsDataChannelIt      = data.find("isDataChannel");
@@ -1385,11 +1390,12 @@ namespace RTC
 		  this, producer, mappedSsrc, worstRemoteFractionLost);
 	}
 
-	inline void Transport::OnConsumerSendRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)
+	inline void Transport::OnConsumerSendRtpPacket(
+	  RTC::Consumer* consumer, const RTC::EgressRtpPacket& egressPacket)
 	{
 		MS_TRACE();
 
-		SendRtpPacket(packet, consumer);
+		SendRtpPacket(egressPacket, consumer);
 	}
 
 	inline void Transport::OnConsumerRetransmitRtpPacket(
@@ -1412,7 +1418,7 @@ namespace RTC
 			}
 		}
 
-		SendRtpPacket(packet, consumer, true, probation);
+		SendRtpPacket(RTC::EgressRtpPacket(packet), consumer, true, probation);
 	}
 
 	inline void Transport::OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc)
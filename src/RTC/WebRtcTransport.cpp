@@ -5,11 +5,13 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
 #include "Channel/Notifier.hpp"
 #include "RTC/RTCP/FeedbackPsRemb.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include <cmath>    // std::pow()
+#include <cstring>  // std::memcpy()
 #include <iterator> // std::ostream_iterator
 #include <map>
 #include <sstream> // std::ostringstream
@@ -23,6 +25,42 @@ namespace RTC
 	static constexpr uint16_t IceTypePreference{ 64 };
 	// We do not support non rtcp-mux so component is always 1.
 	static constexpr uint16_t IceComponent{ 1 };
+	// Packets are paced above the estimated bitrate so the queue does not grow
+	// under normal conditions while key frame bursts are spread.
+	static constexpr float PacingFactor{ 2.5f };
+
+	/* Struct for a RTP packet waiting to be encrypted (or decrypted) in a batch. */
+	struct PendingRtpPacket
+	{
+		RTC::WebRtcTransport* transport{ nullptr };
+		RTC::EgressPriorityQueue::Priority priority;
+		uint8_t store[RTC::MtuSize + SRTP_MAX_TRAILER_LEN];
+		// Used by packets bigger than the MTU (so they are not sent or received
+		// before the packets batched before them).
+		std::vector<uint8_t> largeStore;
+	};
+
+	/* Struct for a batch of RTP packets encrypted (or decrypted) at once. */
+	struct RtpBatch : public RTC::SrtpCryptoPool::Batch
+	{
+		explicit RtpBatch(size_t size) : packets(size)
+		{
+			this->items.resize(size);
+		}
+
+		std::vector<PendingRtpPacket> packets;
+	};
+
+	// Batches being filled, one per crypto pool thread (or a single one).
+	static thread_local std::vector<RtpBatch*> RtpBatches;
+	// Batches handed back by the crypto pool, ready to be filled again.
+	static thread_local std::vector<RtpBatch*> FreeRtpBatches;
+	static thread_local RTC::SrtpCryptoPool* CryptoPool{ nullptr };
+	// Batch the next WebRtcTransport is assigned to.
+	static thread_local size_t NextRtpBatchIdx{ 0 };
+	// Buffer in which packets sent by consumers are assembled and encrypted.
+	static constexpr size_t EgressBufferSize{ RTC::RtpBufferSize };
+	static thread_local uint8_t EgressBuffer[EgressBufferSize];
 
 	static inline uint32_t generateIceCandidatePriority(uint16_t localPreference)
 	{
@@ -32,6 +70,159 @@ namespace RTC
 		       std::pow(2, 0) * (256 - IceComponent);
 	}
 
+	/* Class methods. */
+
+	void WebRtcTransport::ClassInit()
+	{
+		MS_TRACE();
+
+		if (Settings::configuration.srtpBatchSize == 0)
+			return;
+
+		size_t numBatches{ 1 };
+
+		if (Settings::configuration.srtpCryptoThreads > 0)
+		{
+			CryptoPool = new RTC::SrtpCryptoPool(
+			  Settings::configuration.srtpCryptoThreads, WebRtcTransport::OnRtpBatchProcessed);
+			numBatches = CryptoPool->GetNumThreads();
+		}
+
+		for (size_t batchIdx{ 0 }; batchIdx < numBatches; ++batchIdx)
+		{
+			RtpBatches.push_back(new RtpBatch(Settings::configuration.srtpBatchSize));
+		}
+
+		// Must run before the egress queues are drained and UDP batches are sent.
+		DepLibUV::AddFlushCallback(WebRtcTransport::FlushRtpBatch);
+	}
+
+	void WebRtcTransport::ClassDestroy()
+	{
+		MS_TRACE();
+
+		// Batches still in the crypto pool are handed back.
+		delete CryptoPool;
+		CryptoPool = nullptr;
+
+		for (auto* rtpBatch : RtpBatches)
+		{
+			delete rtpBatch;
+		}
+		RtpBatches.clear();
+
+		for (auto* rtpBatch : FreeRtpBatches)
+		{
+			delete rtpBatch;
+		}
+		FreeRtpBatches.clear();
+
+		NextRtpBatchIdx = 0;
+	}
+
+	/**
+	 * Submits the RTP packets deferred by SendRtpPacket() and OnRtpDataReceived()
+	 * once per loop iteration.
+	 */
+	void WebRtcTransport::FlushRtpBatch()
+	{
+		for (size_t batchIdx{ 0 }; batchIdx < RtpBatches.size(); ++batchIdx)
+		{
+			if (RtpBatches[batchIdx]->count != 0)
+				SubmitRtpBatch(batchIdx);
+		}
+	}
+
+	/**
+	 * Gives the given batch to the crypto pool, or encrypts all its RTP packets
+	 * in a single call and sends them if there is no pool.
+	 */
+	void WebRtcTransport::SubmitRtpBatch(size_t batchIdx)
+	{
+		MS_TRACE();
+
+		auto* rtpBatch = RtpBatches[batchIdx];
+
+		for (size_t idx{ 0 }; idx < rtpBatch->count; ++idx)
+		{
+			auto& pendingPacket = rtpBatch->packets[idx];
+			auto& item          = rtpBatch->items[idx];
+			auto* transport     = pendingPacket.transport;
+
+			// The transport may have been closed or disconnected meanwhile.
+			if (!transport || !transport->IsConnected())
+				item.session = nullptr;
+			else if (item.type == RTC::SrtpSession::Type::OUTBOUND)
+				item.session = transport->srtpSendSession;
+			else
+				item.session = transport->srtpRecvSession;
+		}
+
+		if (CryptoPool)
+		{
+			// Keep batching packets while this batch is processed.
+			if (FreeRtpBatches.empty())
+			{
+				RtpBatches[batchIdx] = new RtpBatch(Settings::configuration.srtpBatchSize);
+			}
+			else
+			{
+				RtpBatches[batchIdx] = FreeRtpBatches.back();
+				FreeRtpBatches.pop_back();
+			}
+
+			CryptoPool->Submit(rtpBatch, batchIdx);
+
+			return;
+		}
+
+		RTC::SrtpSession::ProcessRtpBatch(rtpBatch->items.data(), rtpBatch->count);
+
+		OnRtpBatchProcessed(rtpBatch);
+	}
+
+	/**
+	 * Sends the encrypted RTP packets of the given batch and receives the
+	 * decrypted ones, in order.
+	 */
+	void WebRtcTransport::OnRtpBatchProcessed(RTC::SrtpCryptoPool::Batch* batch)
+	{
+		MS_TRACE();
+
+		auto* rtpBatch = static_cast<RtpBatch*>(batch);
+
+		for (size_t idx{ 0 }; idx < rtpBatch->count; ++idx)
+		{
+			auto& pendingPacket = rtpBatch->packets[idx];
+			auto& item          = rtpBatch->items[idx];
+			auto* transport     = pendingPacket.transport;
+
+			// Check the connection again since a previous packet may have closed it.
+			if (!item.session || !transport || !transport->IsConnected())
+				continue;
+
+			if (item.type == RTC::SrtpSession::Type::OUTBOUND)
+			{
+				if (item.processed)
+					transport->SendEncryptedRtpPacket(item.data, item.len, pendingPacket.priority);
+			}
+			else if (item.processed)
+			{
+				// Packets are only batched if they come from the selected tuple.
+				transport->OnRtpDataDecrypted(nullptr, item.data, item.len);
+			}
+			else
+			{
+				transport->OnRtpDataDecryptionFailed(item.data, item.len);
+			}
+		}
+
+		rtpBatch->count = 0;
+
+		if (CryptoPool)
+			FreeRtpBatches.push_back(rtpBatch);
+	}
+
 	/* Instance methods. */
 
 	WebRtcTransport::WebRtcTransport(const std::string& id, RTC::Transport::Listener* listener, json& data)
@@ -39,6 +230,13 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Spread transports among the crypto pool threads.
+		if (!RtpBatches.empty())
+		{
+			this->rtpBatchIdx = NextRtpBatchIdx;
+			NextRtpBatchIdx   = (NextRtpBatchIdx + 1) % RtpBatches.size();
+		}
+
 		bool enableUdp{ true };
 		auto jsonEnableUdpIt = data.find("enableUdp");
 
@@ -153,6 +351,11 @@ namespace RTC
 			  "minimumAvailableOutgoingBitrate bigger than initialAvailableOutgoingBitrate");
 		}
 
+		// ICE credentials are needed before creating the ICE candidates since
+		// shared UDP sockets and TCP servers demultiplex by usernameFragment.
+		std::string iceUsernameFragment = Utils::Crypto::GetRandomString(16);
+		std::string icePassword         = Utils::Crypto::GetRandomString(32);
+
 		try
 		{
 			uint16_t iceLocalPreferenceDecrement{ 0 };
@@ -173,11 +376,25 @@ namespace RTC
 						iceLocalPreference += 1000;
 
 					uint32_t icePriority = generateIceCandidatePriority(iceLocalPreference);
+					RTC::UdpSocket* udpSocket;
 
-					// This may throw.
-					auto* udpSocket = new RTC::UdpSocket(this, listenIp.ip);
+					if (Settings::configuration.sharedUdpSocket)
+					{
+						// This may throw.
+						auto* sharedUdpSocket = RTC::SharedUdpSocket::Acquire(listenIp.ip);
 
-					this->udpSockets[udpSocket] = listenIp.announcedIp;
+						this->sharedUdpSockets.push_back(sharedUdpSocket);
+						sharedUdpSocket->AddUsernameFragment(iceUsernameFragment, this);
+
+						udpSocket = sharedUdpSocket->GetUdpSocket();
+					}
+					else
+					{
+						// This may throw.
+						udpSocket = new RTC::UdpSocket(this, listenIp.ip);
+
+						this->udpSockets[udpSocket] = listenIp.announcedIp;
+					}
 
 					if (listenIp.announcedIp.empty())
 						this->iceCandidates.emplace_back(udpSocket, icePriority);
@@ -194,11 +411,25 @@ namespace RTC
 						iceLocalPreference += 1000;
 
 					uint32_t icePriority = generateIceCandidatePriority(iceLocalPreference);
+					RTC::TcpServer* tcpServer;
 
-					// This may throw.
-					auto* tcpServer = new RTC::TcpServer(this, this, listenIp.ip);
+					if (Settings::configuration.sharedTcpServer)
+					{
+						// This may throw.
+						auto* sharedTcpServer = RTC::SharedTcpServer::Acquire(listenIp.ip);
 
-					this->tcpServers[tcpServer] = listenIp.announcedIp;
+						this->sharedTcpServers.push_back(sharedTcpServer);
+						sharedTcpServer->AddUsernameFragment(iceUsernameFragment, this, this);
+
+						tcpServer = sharedTcpServer->GetTcpServer();
+					}
+					else
+					{
+						// This may throw.
+						tcpServer = new RTC::TcpServer(this, this, listenIp.ip);
+
+						this->tcpServers[tcpServer] = listenIp.announcedIp;
+					}
 
 					if (listenIp.announcedIp.empty())
 						this->iceCandidates.emplace_back(tcpServer, icePriority);
@@ -211,8 +442,7 @@ namespace RTC
 			}
 
 			// Create a ICE server.
-			this->iceServer = new RTC::IceServer(
-			  this, Utils::Crypto::GetRandomString(16), Utils::Crypto::GetRandomString(32));
+			this->iceServer = new RTC::IceServer(this, iceUsernameFragment, icePassword);
 
 			// Create a DTLS transport.
 			this->dtlsTransport = new RTC::DtlsTransport(this);
@@ -240,6 +470,13 @@ namespace RTC
 			}
 			this->udpSockets.clear();
 
+			for (auto* sharedUdpSocket : this->sharedUdpSockets)
+			{
+				sharedUdpSocket->RemoveListener(this);
+				RTC::SharedUdpSocket::Release(sharedUdpSocket);
+			}
+			this->sharedUdpSockets.clear();
+
 			for (auto& kv : this->tcpServers)
 			{
 				auto* tcpServer = kv.first;
@@ -248,6 +485,13 @@ namespace RTC
 			}
 			this->tcpServers.clear();
 
+			for (auto* sharedTcpServer : this->sharedTcpServers)
+			{
+				sharedTcpServer->RemoveListener(this);
+				RTC::SharedTcpServer::Release(sharedTcpServer);
+			}
+			this->sharedTcpServers.clear();
+
 			this->iceCandidates.clear();
 
 			throw;
@@ -261,6 +505,33 @@ namespace RTC
 		// Must delete the SCTP association first since it will generate SCTP packets.
 		DestroySctpAssociation();
 
+		// Forget RTP packets waiting in batches. The crypto pool must be done with
+		// the ones using our SRTP sessions.
+		WaitForCryptoPool();
+
+		for (auto* rtpBatch : RtpBatches)
+		{
+			for (size_t idx{ 0 }; idx < rtpBatch->count; ++idx)
+			{
+				if (rtpBatch->packets[idx].transport == this)
+					rtpBatch->packets[idx].transport = nullptr;
+			}
+		}
+
+		if (CryptoPool)
+		{
+			for (auto* batch : CryptoPool->GetPendingBatches())
+			{
+				auto* rtpBatch = static_cast<RtpBatch*>(batch);
+
+				for (size_t idx{ 0 }; idx < rtpBatch->count; ++idx)
+				{
+					if (rtpBatch->packets[idx].transport == this)
+						rtpBatch->packets[idx].transport = nullptr;
+				}
+			}
+		}
+
 		// Must delete the DTLS transport first since it will generate a DTLS alert
 		// to be sent.
 		delete this->dtlsTransport;
@@ -275,6 +546,13 @@ namespace RTC
 		}
 		this->udpSockets.clear();
 
+		for (auto* sharedUdpSocket : this->sharedUdpSockets)
+		{
+			sharedUdpSocket->RemoveListener(this);
+			RTC::SharedUdpSocket::Release(sharedUdpSocket);
+		}
+		this->sharedUdpSockets.clear();
+
 		for (auto& kv : this->tcpServers)
 		{
 			auto* tcpServer = kv.first;
@@ -282,6 +560,13 @@ namespace RTC
 			delete tcpServer;
 		}
 
+		for (auto* sharedTcpServer : this->sharedTcpServers)
+		{
+			sharedTcpServer->RemoveListener(this);
+			RTC::SharedTcpServer::Release(sharedTcpServer);
+		}
+		this->sharedTcpServers.clear();
+
 		this->iceCandidates.clear();
 
 		delete this->srtpRecvSession;
@@ -529,6 +814,41 @@ namespace RTC
 		// Add maxIncomingBitrate.
 		if (this->maxIncomingBitrate != 0u)
 			jsonObject["maxIncomingBitrate"] = this->maxIncomingBitrate;
+
+		// Add udpSendBatches and udpSendBatchedDatagrams (average batch size is
+		// their ratio), udpSendQueuedBytes and udpSendDrops.
+		size_t udpSendBatches{ 0 };
+		size_t udpSendBatchedDatagrams{ 0 };
+		size_t udpSendQueuedBytes{ 0 };
+		size_t udpSendDrops{ 0 };
+
+		for (auto& kv : this->udpSockets)
+		{
+			auto* udpSocket = kv.first;
+
+			udpSendBatches += udpSocket->GetSendBatches();
+			udpSendBatchedDatagrams += udpSocket->GetSendBatchedDatagrams();
+			udpSendQueuedBytes += udpSocket->GetSendQueuedBytes();
+			udpSendDrops += udpSocket->GetSendDrops();
+		}
+
+		for (auto* sharedUdpSocket : this->sharedUdpSockets)
+		{
+			auto* udpSocket = sharedUdpSocket->GetUdpSocket();
+
+			udpSendBatches += udpSocket->GetSendBatches();
+			udpSendBatchedDatagrams += udpSocket->GetSendBatchedDatagrams();
+			udpSendQueuedBytes += udpSocket->GetSendQueuedBytes();
+			udpSendDrops += udpSocket->GetSendDrops();
+		}
+
+		jsonObject["udpSendBatches"]          = udpSendBatches;
+		jsonObject["udpSendBatchedDatagrams"] = udpSendBatchedDatagrams;
+		jsonObject["udpSendQueuedBytes"]      = udpSendQueuedBytes;
+		jsonObject["udpSendDrops"]            = udpSendDrops;
+
+		// Add egressQueuePackets, egressQueueBytes and egressQueueDrops.
+		this->egressQueue.FillJsonStats(jsonObject);
 	}
 
 	void WebRtcTransport::HandleRequest(Channel::Request* request)
@@ -695,6 +1015,18 @@ namespace RTC
 				this->iceServer->SetUsernameFragment(usernameFragment);
 				this->iceServer->SetPassword(password);
 
+				// The old usernameFragment is kept since the IceServer still accepts it
+				// until the new one is used.
+				for (auto* sharedUdpSocket : this->sharedUdpSockets)
+				{
+					sharedUdpSocket->AddUsernameFragment(usernameFragment, this);
+				}
+
+				for (auto* sharedTcpServer : this->sharedTcpServers)
+				{
+					sharedTcpServer->AddUsernameFragment(usernameFragment, this, this);
+				}
+
 				MS_DEBUG_DEV(
 				  "WebRtcTransport ICE usernameFragment and password changed [id:%s]", this->id.c_str());
 
@@ -803,7 +1135,10 @@ namespace RTC
 	}
 
 	void WebRtcTransport::SendRtpPacket(
-	  RTC::RtpPacket* packet, RTC::Consumer* consumer, bool retransmitted, bool probation)
+	  const RTC::EgressRtpPacket& egressPacket,
+	  RTC::Consumer* consumer,
+	  bool retransmitted,
+	  bool probation)
 	{
 		MS_TRACE();
 
@@ -818,17 +1153,56 @@ namespace RTC
 			return;
 		}
 
-		auto seq            = packet->GetSequenceNumber();
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		auto* packet = egressPacket.GetPacket();
+		auto seq     = egressPacket.GetSequenceNumber();
+		size_t len   = egressPacket.GetSize();
+		RTC::EgressPriorityQueue::Priority priority;
+
+		if (probation)
+			priority = RTC::EgressPriorityQueue::Priority::PROBATION;
+		else if (retransmitted)
+			priority = RTC::EgressPriorityQueue::Priority::RTX;
+		else if (consumer->GetKind() == RTC::Media::Kind::AUDIO)
+			priority = RTC::EgressPriorityQueue::Priority::AUDIO;
+		else
+			priority = RTC::EgressPriorityQueue::Priority::VIDEO;
+
+		// Packets owned by the consumer (retransmissions) already carry the
+		// consumer header and are encrypted in their own memory if it has room
+		// for the SRTP trailer, unless batching is enabled (so they are not sent
+		// before the packets they repair). Others are shared with other consumers
+		// so the consumer header and the rest of the packet are assembled, either
+		// into the next batch (if enabled) or into the egress buffer.
+		if (RtpBatches.empty() && packet->GetTailroom() >= SRTP_MAX_TRAILER_LEN)
+		{
+			auto* data = const_cast<uint8_t*>(packet->GetData());
+
+			std::memcpy(data, egressPacket.GetHeader(), RTC::EgressRtpPacket::HeaderSize);
+
+			if (!this->srtpSendSession->EncryptRtpInPlace(data, &len))
+				return;
+
+			SendEncryptedRtpPacket(data, len, priority);
+		}
+		else if (len + SRTP_MAX_TRAILER_LEN > EgressBufferSize)
+		{
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%zu bytes)", len);
 
-		if (!this->srtpSendSession->EncryptRtp(&data, &len))
 			return;
+		}
+		else if (!RtpBatches.empty())
+		{
+			egressPacket.Write(AddRtpBatchPacket(RTC::SrtpSession::Type::OUTBOUND, len, priority));
+		}
+		else
+		{
+			egressPacket.Write(EgressBuffer);
 
-		this->iceSelectedTuple->Send(data, len);
+			if (!this->srtpSendSession->EncryptRtpInPlace(EgressBuffer, &len))
+				return;
 
-		// Increase send transmission.
-		RTC::Transport::DataSent(len);
+			SendEncryptedRtpPacket(EgressBuffer, len, priority);
+		}
 
 		// Feed the REMB client if this is a simulcast or SVC Consumer.
 		// clang-format off
@@ -861,6 +1235,98 @@ namespace RTC
 		}
 	}
 
+	void WebRtcTransport::SendEncryptedRtpPacket(
+	  const uint8_t* data, size_t len, RTC::EgressPriorityQueue::Priority priority)
+	{
+		MS_TRACE();
+
+		// Send it now unless older packets are waiting, the socket is backlogged
+		// or the pacer has no budget. Otherwise queue it so audio goes out before
+		// video, RTX and probation.
+		if (
+		  !this->egressQueue.IsEmpty() || this->iceSelectedTuple->IsBacklogged() ||
+		  !this->egressQueue.UsePacingBudget(len))
+		{
+			this->egressQueue.Push(priority, data, len);
+		}
+		else
+		{
+			this->iceSelectedTuple->Send(data, len);
+
+			// Increase send transmission.
+			RTC::Transport::DataSent(len);
+		}
+	}
+
+	/**
+	 * Adds a RTP packet of the given length to the batch of this transport and
+	 * returns the memory it must be written into.
+	 */
+	uint8_t* WebRtcTransport::AddRtpBatchPacket(
+	  RTC::SrtpSession::Type type, size_t len, RTC::EgressPriorityQueue::Priority priority)
+	{
+		MS_TRACE();
+
+		auto* rtpBatch = RtpBatches[this->rtpBatchIdx];
+
+		if (rtpBatch->count == rtpBatch->items.size())
+		{
+			SubmitRtpBatch(this->rtpBatchIdx);
+
+			rtpBatch = RtpBatches[this->rtpBatchIdx];
+		}
+
+		auto& pendingPacket = rtpBatch->packets[rtpBatch->count];
+		auto& item          = rtpBatch->items[rtpBatch->count];
+
+		++rtpBatch->count;
+
+		pendingPacket.transport = this;
+		pendingPacket.priority  = priority;
+		item.type               = type;
+		item.len                = len;
+
+		if (len <= RTC::MtuSize)
+		{
+			item.data = pendingPacket.store;
+		}
+		else
+		{
+			pendingPacket.largeStore.resize(len + SRTP_MAX_TRAILER_LEN);
+
+			item.data = pendingPacket.largeStore.data();
+		}
+
+		return item.data;
+	}
+
+	/**
+	 * Blocks until the crypto pool is done with the packets of this transport
+	 * submitted to it, so its SRTP sessions can be deleted.
+	 */
+	void WebRtcTransport::WaitForCryptoPool() const
+	{
+		MS_TRACE();
+
+		if (!CryptoPool)
+			return;
+
+		for (auto* batch : CryptoPool->GetPendingBatches())
+		{
+			auto* rtpBatch = static_cast<RtpBatch*>(batch);
+
+			for (size_t idx{ 0 }; idx < rtpBatch->count; ++idx)
+			{
+				if (rtpBatch->packets[idx].transport == this)
+				{
+					CryptoPool->Wait();
+
+					return;
+				}
+			}
+		}
+	}
+
 	void WebRtcTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
 	{
 		MS_TRACE();
@@ -1094,7 +1560,8 @@ namespace RTC
 		}
 
 		// Trick for clients performing aggressive ICE regardless we are ICE-Lite.
-		this->iceServer->ForceSelectedTuple(tuple);
+		if (tuple)
+			this->iceServer->ForceSelectedTuple(tuple);
 
 		// Check that DTLS status is 'connecting' or 'connected'.
 		if (
@@ -1142,30 +1609,45 @@ namespace RTC
 			return;
 		}
 
+		// Let the crypto pool decrypt it if it comes from the selected tuple (so
+		// the tuple does not need to be kept). Packets of this transport are
+		// received in order.
+		// clang-format off
+		if (
+			CryptoPool &&
+			this->iceSelectedTuple &&
+			this->iceSelectedTuple->Compare(tuple)
+		)
+		// clang-format on
+		{
+			// The priority is just used for outgoing packets.
+			auto* store = AddRtpBatchPacket(
+			  RTC::SrtpSession::Type::INBOUND, len, RTC::EgressPriorityQueue::Priority::AUDIO);
+
+			std::memcpy(store, data, len);
+
+			return;
+		}
+
 		// Decrypt the SRTP packet.
 		if (!this->srtpRecvSession->DecryptSrtp(data, &len))
 		{
-			RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
-
-			if (packet == nullptr)
-			{
-				MS_WARN_TAG(srtp, "DecryptSrtp() failed due to an invalid RTP packet");
-			}
-			else
-			{
-				MS_WARN_TAG(
-				  srtp,
-				  "DecryptSrtp() failed [ssrc:%" PRIu32 ", payloadType:%" PRIu8 ", seq:%" PRIu16 "]",
-				  packet->GetSsrc(),
-				  packet->GetPayloadType(),
-				  packet->GetSequenceNumber());
-
-				delete packet;
-			}
+			OnRtpDataDecryptionFailed(data, len);
 
 			return;
 		}
 
+		OnRtpDataDecrypted(tuple, data, len);
+	}
+
+	/**
+	 * The given tuple is null if the packet came from the selected tuple.
+	 */
+	void WebRtcTransport::OnRtpDataDecrypted(
+	  RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
 		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
 		if (packet == nullptr)
@@ -1216,7 +1698,8 @@ namespace RTC
 		//   producer->id.c_str());
 
 		// Trick for clients performing aggressive ICE regardless we are ICE-Lite.
-		this->iceServer->ForceSelectedTuple(tuple);
+		if (tuple)
+			this->iceServer->ForceSelectedTuple(tuple);
 
 		// Pass the RTP packet to the corresponding Producer.
 		producer->ReceiveRtpPacket(packet);
@@ -1224,6 +1707,29 @@ namespace RTC
 		delete packet;
 	}
 
+	void WebRtcTransport::OnRtpDataDecryptionFailed(const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
+
+		if (packet == nullptr)
+		{
+			MS_WARN_TAG(srtp, "DecryptSrtp() failed due to an invalid RTP packet");
+		}
+		else
+		{
+			MS_WARN_TAG(
+			  srtp,
+			  "DecryptSrtp() failed [ssrc:%" PRIu32 ", payloadType:%" PRIu8 ", seq:%" PRIu16 "]",
+			  packet->GetSsrc(),
+			  packet->GetPayloadType(),
+			  packet->GetSequenceNumber());
+
+			delete packet;
+		}
+	}
+
 	inline void WebRtcTransport::OnRtcpDataReceived(
 	  RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
 	{
@@ -1350,6 +1856,9 @@ namespace RTC
 			this->rembClient = new RTC::RembClient(
 			  this, this->initialAvailableOutgoingBitrate, this->minimumAvailableOutgoingBitrate);
 
+			this->egressQueue.SetPacingBitrate(
+			  static_cast<uint32_t>(this->initialAvailableOutgoingBitrate * PacingFactor));
+
 			// Tell all the Consumers that we are gonna manage their bitrate.
 			for (auto& kv : this->mapConsumers)
 			{
@@ -1407,6 +1916,14 @@ namespace RTC
 		OnPacketReceived(&tuple, data, len);
 	}
 
+	inline void WebRtcTransport::OnRtcTcpConnectionAccepted(
+	  RTC::TcpServer* /*tcpServer*/, RTC::TcpConnection* /*connection*/)
+	{
+		MS_TRACE();
+
+		// Do nothing.
+	}
+
 	inline void WebRtcTransport::OnRtcTcpConnectionClosed(
 	  RTC::TcpServer* /*tcpServer*/, RTC::TcpConnection* connection)
 	{
@@ -1439,6 +1956,19 @@ namespace RTC
 		RTC::Transport::DataSent(packet->GetSize());
 	}
 
+	inline void WebRtcTransport::OnIceServerTupleAdded(
+	  const RTC::IceServer* /*iceServer*/, RTC::TransportTuple* tuple)
+	{
+		MS_TRACE();
+
+		// The remote address has been authenticated (MESSAGE-INTEGRITY), so let
+		// shared sockets give us the rest of packets coming from it.
+		for (auto* sharedUdpSocket : this->sharedUdpSockets)
+		{
+			sharedUdpSocket->AddRemoteAddress(tuple, this);
+		}
+	}
+
 	inline void WebRtcTransport::OnIceServerSelectedTuple(
 	  const RTC::IceServer* /*iceServer*/, RTC::TransportTuple* tuple)
 	{
@@ -1505,6 +2035,9 @@ namespace RTC
 		// Unset the selected tuple.
 		this->iceSelectedTuple = nullptr;
 
+		// Queued packets would be too old once reconnected.
+		this->egressQueue.Clear();
+
 		MS_DEBUG_TAG(ice, "ICE disconnected");
 
 		// Notify the Node WebRtcTransport.
@@ -1545,6 +2078,9 @@ namespace RTC
 
 		MS_DEBUG_TAG(dtls, "DTLS connected");
 
+		// The crypto pool may be using the current SRTP sessions.
+		WaitForCryptoPool();
+
 		// Close it if it was already set and update it.
 		if (this->srtpSendSession != nullptr)
 		{
@@ -1664,9 +2200,30 @@ namespace RTC
 
 		MS_DEBUG_TAG(bwe, "outgoing available bitrate [bitrate:%" PRIu32 "bps]", availableBitrate);
 
+		this->egressQueue.SetPacingBitrate(static_cast<uint32_t>(availableBitrate * PacingFactor));
+
 		DistributeAvailableOutgoingBitrate();
 	}
 
+	inline bool WebRtcTransport::OnEgressPriorityQueueCanSend(
+	  const RTC::EgressPriorityQueue* /*egressQueue*/)
+	{
+		MS_TRACE();
+
+		return IsConnected() && !this->iceSelectedTuple->IsBacklogged();
+	}
+
+	inline void WebRtcTransport::OnEgressPriorityQueueSend(
+	  const RTC::EgressPriorityQueue* /*egressQueue*/, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		this->iceSelectedTuple->Send(data, len);
+
+		// Increase send transmission.
+		RTC::Transport::DataSent(len);
+	}
+
 	inline void WebRtcTransport::OnRembServerAvailableBitrate(
 	  const RTC::RembServer::RemoteBitrateEstimator* /*rembServer*/,
 	  const std::vector<uint32_t>& ssrcs,
@@ -53,6 +53,19 @@ void Settings::SetConfiguration(int argc, char* argv[])
 		{ "rtcMaxPort",          optional_argument, nullptr, 'M' },
 		{ "dtlsCertificateFile", optional_argument, nullptr, 'c' },
 		{ "dtlsPrivateKeyFile",  optional_argument, nullptr, 'p' },
+		{ "udpRecvBatchSize",    optional_argument, nullptr, 'r' },
+		{ "udpSendBatchSize",    optional_argument, nullptr, 's' },
+		{ "udpGro",              optional_argument, nullptr, 'g' },
+		{ "udpSendQueueMaxBytes", optional_argument, nullptr, 'Q' },
+		{ "pacerBurstBytes",     optional_argument, nullptr, 'B' },
+		{ "sharedUdpSocket",     optional_argument, nullptr, 'u' },
+		{ "sharedTcpServer",     optional_argument, nullptr, 'T' },
+		{ "ioUring",             optional_argument, nullptr, 'i' },
+		{ "nativeSrtp",          optional_argument, nullptr, 'n' },
+		{ "srtpBatchSize",       optional_argument, nullptr, 'b' },
+		{ "workerThreads",       optional_argument, nullptr, 'w' },
+		{ "srtpCryptoThreads",   optional_argument, nullptr, 'k' },
+		{ "dtlsHandshakeThreads", optional_argument, nullptr, 'd' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
@@ -129,6 +142,190 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				break;
 			}
 
+			case 'r':
+			{
+				try
+				{
+					Settings::configuration.udpRecvBatchSize = static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 's':
+			{
+				try
+				{
+					Settings::configuration.udpSendBatchSize = static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'Q':
+			{
+				try
+				{
+					Settings::configuration.udpSendQueueMaxBytes =
+					  static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'B':
+			{
+				try
+				{
+					Settings::configuration.pacerBurstBytes = static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'g':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.udpGro = true;
+				else if (stringValue == "false")
+					Settings::configuration.udpGro = false;
+				else
+					MS_THROW_TYPE_ERROR("invalid value '%s' for udpGro", stringValue.c_str());
+
+				break;
+			}
+
+			case 'u':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.sharedUdpSocket = true;
+				else if (stringValue == "false")
+					Settings::configuration.sharedUdpSocket = false;
+				else
+					MS_THROW_TYPE_ERROR("invalid value '%s' for sharedUdpSocket", stringValue.c_str());
+
+				break;
+			}
+
+			case 'T':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.sharedTcpServer = true;
+				else if (stringValue == "false")
+					Settings::configuration.sharedTcpServer = false;
+				else
+					MS_THROW_TYPE_ERROR("invalid value '%s' for sharedTcpServer", stringValue.c_str());
+
+				break;
+			}
+
+			case 'i':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.ioUring = true;
+				else if (stringValue == "false")
+					Settings::configuration.ioUring = false;
+				else
+					MS_THROW_TYPE_ERROR("invalid value '%s' for ioUring", stringValue.c_str());
+
+				break;
+			}
+
+			case 'n':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue == "true")
+					Settings::configuration.nativeSrtp = true;
+				else if (stringValue == "false")
+					Settings::configuration.nativeSrtp = false;
+				else
+					MS_THROW_TYPE_ERROR("invalid value '%s' for nativeSrtp", stringValue.c_str());
+
+				break;
+			}
+
+			case 'b':
+			{
+				try
+				{
+					Settings::configuration.srtpBatchSize = static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'w':
+			{
+				try
+				{
+					Settings::configuration.workerThreads = static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'k':
+			{
+				try
+				{
+					Settings::configuration.srtpCryptoThreads = static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'd':
+			{
+				try
+				{
+					Settings::configuration.dtlsHandshakeThreads =
+					  static_cast<uint16_t>(std::stoi(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
 			// Invalid option.
 			case '?':
 			{
@@ -162,6 +359,21 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	if (Settings::configuration.rtcMaxPort < Settings::configuration.rtcMinPort)
 		MS_THROW_TYPE_ERROR("rtcMinPort cannot be less than than rtcMinPort");
 
+	// Validate worker threads.
+	if (Settings::configuration.workerThreads > 256)
+		MS_THROW_TYPE_ERROR("workerThreads cannot be higher than 256");
+
+	// Validate SRTP crypto threads.
+	if (Settings::configuration.srtpCryptoThreads > 64)
+		MS_THROW_TYPE_ERROR("srtpCryptoThreads cannot be higher than 64");
+	else if (
+	  Settings::configuration.srtpCryptoThreads > 0 && Settings::configuration.srtpBatchSize == 0)
+		MS_THROW_TYPE_ERROR("srtpCryptoThreads requires srtpBatchSize");
+
+	// Validate DTLS handshake threads.
+	if (Settings::configuration.dtlsHandshakeThreads > 64)
+		MS_THROW_TYPE_ERROR("dtlsHandshakeThreads cannot be higher than 64");
+
 	// Set DTLS certificate files (if provided),
 	Settings::SetDtlsCertificateAndPrivateKeyFiles();
 }
@@ -214,6 +426,32 @@ void Settings::PrintConfiguration()
 	MS_DEBUG_TAG(info, "  logTags             : %s", logTagsStream.str().c_str());
 	MS_DEBUG_TAG(info, "  rtcMinPort          : %" PRIu16, Settings::configuration.rtcMinPort);
 	MS_DEBUG_TAG(info, "  rtcMaxPort          : %" PRIu16, Settings::configuration.rtcMaxPort);
+	MS_DEBUG_TAG(
+	  info, "  udpRecvBatchSize    : %" PRIu16, Settings::configuration.udpRecvBatchSize);
+	MS_DEBUG_TAG(
+	  info, "  udpSendBatchSize    : %" PRIu16, Settings::configuration.udpSendBatchSize);
+	MS_DEBUG_TAG(info, "  udpGro              : %s", Settings::configuration.udpGro ? "yes" : "no");
+	MS_DEBUG_TAG(
+	  info, "  udpSendQueueMaxBytes: %" PRIu32, Settings::configuration.udpSendQueueMaxBytes);
+	MS_DEBUG_TAG(info, "  pacerBurstBytes     : %" PRIu32, Settings::configuration.pacerBurstBytes);
+	MS_DEBUG_TAG(
+	  info,
+	  "  sharedUdpSocket     : %s",
+	  Settings::configuration.sharedUdpSocket ? "yes" : "no");
+	MS_DEBUG_TAG(
+	  info,
+	  "  sharedTcpServer     : %s",
+	  Settings::configuration.sharedTcpServer ? "yes" : "no");
+	MS_DEBUG_TAG(
+	  info, "  ioUring             : %s", Settings::configuration.ioUring ? "yes" : "no");
+	MS_DEBUG_TAG(
+	  info, "  nativeSrtp          : %s", Settings::configuration.nativeSrtp ? "yes" : "no");
+	MS_DEBUG_TAG(info, "  srtpBatchSize       : %" PRIu16, Settings::configuration.srtpBatchSize);
+	MS_DEBUG_TAG(info, "  workerThreads       : %" PRIu16, Settings::configuration.workerThreads);
+	MS_DEBUG_TAG(
+	  info, "  srtpCryptoThreads   : %" PRIu16, Settings::configuration.srtpCryptoThreads);
+	MS_DEBUG_TAG(
+	  info, "  dtlsHandshakeThreads: %" PRIu16, Settings::configuration.dtlsHandshakeThreads);
 	if (!Settings::configuration.dtlsCertificateFile.empty())
 	{
 		MS_DEBUG_TAG(
@@ -4049,7 +4049,7 @@ case 86:
 	{
 		MS_TRACE();
 
-		static sockaddr_storage addrStorage;
+		static thread_local sockaddr_storage addrStorage;
 		char ipBuffer[INET6_ADDRSTRLEN+1];
 		int err;
 
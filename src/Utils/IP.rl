@@ -119,7 +119,7 @@ namespace Utils
 	{
 		MS_TRACE();
 
-		static sockaddr_storage addrStorage;
+		static thread_local sockaddr_storage addrStorage;
 		char ipBuffer[INET6_ADDRSTRLEN+1];
 		int err;
 
@@ -24,6 +24,12 @@ Worker::Worker(Channel::UnixStreamSocket* channel) : channel(channel)
 	this->signalsHandler->AddSignal(SIGINT, "INT");
 	this->signalsHandler->AddSignal(SIGTERM, "TERM");
 
+	// Create the threads running Routers (if any).
+	for (uint16_t i{ 0 }; i < Settings::configuration.workerThreads; ++i)
+	{
+		this->workerThreads.push_back(new WorkerThread(this->channel));
+	}
+
 	// Tell the Node process that we are running.
 	Channel::Notifier::Emit(std::to_string(Logger::pid), "running");
 
@@ -61,6 +67,14 @@ void Worker::Close()
 	}
 	this->mapRouters.clear();
 
+	// Delete all WorkerThreads (and hence their Routers).
+	for (auto* workerThread : this->workerThreads)
+	{
+		delete workerThread;
+	}
+	this->workerThreads.clear();
+	this->mapRouterIdWorkerThread.clear();
+
 	// Close the Channel.
 	delete this->channel;
 }
@@ -82,6 +96,40 @@ void Worker::FillJson(json& jsonObject) const
 
 		jsonRouterIdsIt->emplace_back(routerId);
 	}
+
+	for (auto& kv : this->mapRouterIdWorkerThread)
+	{
+		auto& routerId = kv.first;
+
+		jsonRouterIdsIt->emplace_back(routerId);
+	}
+
+	// Add loops (the main one and the one of each WorkerThread).
+	jsonObject["loops"] = json::array();
+	auto jsonLoopsIt    = jsonObject.find("loops");
+
+	FillJsonLoopStats(DepLibUV::GetLoopStats(), *jsonLoopsIt);
+
+	for (auto* workerThread : this->workerThreads)
+	{
+		FillJsonLoopStats(workerThread->GetLoopStats(), *jsonLoopsIt);
+	}
+}
+
+void Worker::FillJsonLoopStats(const DepLibUV::LoopStats* stats, json& jsonArray) const
+{
+	MS_TRACE();
+
+	json jsonLoop = json::object();
+
+	jsonLoop["iterations"]  = stats->iterations.load(std::memory_order_relaxed);
+	jsonLoop["busyTimeMs"]  = stats->busyTimeNs.load(std::memory_order_relaxed) / 1000000;
+	jsonLoop["stalls"]      = stats->stalls.load(std::memory_order_relaxed);
+	jsonLoop["stallTimeMs"] = stats->stallTimeNs.load(std::memory_order_relaxed) / 1000000;
+	jsonLoop["maxIterationTimeMs"] =
+	  stats->maxIterationTimeNs.load(std::memory_order_relaxed) / 1000000;
+
+	jsonArray.push_back(jsonLoop);
 }
 
 void Worker::SetNewRouterIdFromRequest(Channel::Request* request, std::string& routerId) const
@@ -95,8 +143,12 @@ void Worker::SetNewRouterIdFromRequest(Channel::Request* request, std::string& r
 
 	routerId.assign(jsonRouterIdIt->get<std::string>());
 
-	if (this->mapRouters.find(routerId) != this->mapRouters.end())
+	if (
+	  this->mapRouters.find(routerId) != this->mapRouters.end() ||
+	  this->mapRouterIdWorkerThread.find(routerId) != this->mapRouterIdWorkerThread.end())
+	{
 		MS_THROW_ERROR("a Router with same routerId already exists");
+	}
 }
 
 RTC::Router* Worker::GetRouterFromRequest(Channel::Request* request) const
@@ -118,6 +170,60 @@ RTC::Router* Worker::GetRouterFromRequest(Channel::Request* request) const
 	return router;
 }
 
+/**
+ * Returns the WorkerThread running the Router of the request, or nullptr if
+ * the Router runs in the main loop.
+ */
+WorkerThread* Worker::GetWorkerThreadFromRequest(Channel::Request* request) const
+{
+	MS_TRACE();
+
+	auto jsonRouterIdIt = request->internal.find("routerId");
+
+	if (jsonRouterIdIt == request->internal.end() || !jsonRouterIdIt->is_string())
+		MS_THROW_ERROR("request has no internal.routerId");
+
+	auto it = this->mapRouterIdWorkerThread.find(jsonRouterIdIt->get<std::string>());
+
+	if (it == this->mapRouterIdWorkerThread.end())
+		return nullptr;
+
+	WorkerThread* workerThread = it->second;
+
+	return workerThread;
+}
+
+/**
+ * Returns the WorkerThread running less Routers, or nullptr if there are no
+ * WorkerThreads.
+ */
+WorkerThread* Worker::GetWorkerThreadForNewRouter() const
+{
+	MS_TRACE();
+
+	WorkerThread* selectedWorkerThread{ nullptr };
+	size_t selectedNumRouters{ 0 };
+
+	for (auto* workerThread : this->workerThreads)
+	{
+		size_t numRouters{ 0 };
+
+		for (auto& kv : this->mapRouterIdWorkerThread)
+		{
+			if (kv.second == workerThread)
+				++numRouters;
+		}
+
+		if (!selectedWorkerThread || numRouters < selectedNumRouters)
+		{
+			selectedWorkerThread = workerThread;
+			selectedNumRouters   = numRouters;
+		}
+	}
+
+	return selectedWorkerThread;
+}
+
 inline void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::Request* request)
 {
 	MS_TRACE();
@@ -152,6 +258,18 @@ inline void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Cha
 			// This may throw.
 			SetNewRouterIdFromRequest(request, routerId);
 
+			auto* workerThread = GetWorkerThreadForNewRouter();
+
+			// The WorkerThread replies to its own copy of the request.
+			if (workerThread)
+			{
+				this->mapRouterIdWorkerThread[routerId] = workerThread;
+
+				workerThread->PostRequest(new Channel::Request(*request));
+
+				break;
+			}
+
 			auto* router = new RTC::Router(routerId);
 
 			this->mapRouters[routerId] = router;
@@ -165,15 +283,27 @@ inline void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Cha
 
 		case Channel::Request::MethodId::ROUTER_CLOSE:
 		{
+			// This may throw.
+			auto* workerThread = GetWorkerThreadFromRequest(request);
+
+			if (workerThread)
+			{
+				this->mapRouterIdWorkerThread.erase(request->internal["routerId"].get<std::string>());
+
+				workerThread->PostRequest(new Channel::Request(*request));
+
+				break;
+			}
+
 			// This may throw.
 			RTC::Router* router = GetRouterFromRequest(request);
 
+			MS_DEBUG_DEV("Router closed [id:%s]", router->id.c_str());
+
 			// Remove it from the map and delete it.
 			this->mapRouters.erase(router->id);
 			delete router;
 
-			MS_DEBUG_DEV("Router closed [id:%s]", router->id.c_str());
-
 			request->Accept();
 
 			break;
@@ -182,6 +312,16 @@ inline void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Cha
 		// Any other request must be delivered to the corresponding Router.
 		default:
 		{
+			// This may throw.
+			auto* workerThread = GetWorkerThreadFromRequest(request);
+
+			if (workerThread)
+			{
+				workerThread->PostRequest(new Channel::Request(*request));
+
+				break;
+			}
+
 			// This may throw.
 			RTC::Router* router = GetRouterFromRequest(request);
 
@@ -0,0 +1,313 @@
+#define MS_CLASS "WorkerThread"
+// #define MS_LOG_DEV
+
+#include "WorkerThread.hpp"
+#include "BufferPool.hpp"
+#include "DepLibUV.hpp"
+#include "DepLibUring.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include "RTC/DtlsHandshakePool.hpp"
+#include "RTC/EgressPriorityQueue.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/SharedMemoryPipe.hpp"
+#include "RTC/SharedRtpPacket.hpp"
+#include "RTC/WebRtcTransport.hpp"
+#include "handles/UdpSocket.hpp"
+
+/* Static. */
+
+static constexpr size_t RequestsQueueSize{ 1024 };
+static constexpr size_t MessagesQueueSize{ 65536 };
+
+/* Static methods for UV callbacks. */
+
+inline static void onRequests(uv_async_t* handle)
+{
+	static_cast<WorkerThread*>(handle->data)->OnUvRequests();
+}
+
+inline static void onMessages(uv_async_t* handle)
+{
+	static_cast<WorkerThread*>(handle->data)->DeliverMessages();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Instance methods. */
+
+WorkerThread::WorkerThread(Channel::UnixStreamSocket* channel)
+  : ChannelThread(channel, MessagesQueueSize, ChannelThread::QueueFullPolicy::WAIT),
+    requests(RequestsQueueSize)
+{
+	MS_TRACE();
+
+	this->messagesUvHandle       = new uv_async_t;
+	this->messagesUvHandle->data = (void*)this;
+
+	int err = uv_async_init(
+	  DepLibUV::GetLoop(), this->messagesUvHandle, static_cast<uv_async_cb>(onMessages));
+
+	if (err != 0)
+	{
+		delete this->messagesUvHandle;
+		this->messagesUvHandle = nullptr;
+
+		MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+	}
+
+	// It must not keep the main loop alive.
+	uv_unref(reinterpret_cast<uv_handle_t*>(this->messagesUvHandle));
+
+	uv_sem_init(&this->readySem, 0);
+
+	try
+	{
+		Start();
+	}
+	catch (const MediaSoupError& /*error*/)
+	{
+		uv_sem_destroy(&this->readySem);
+		uv_close(reinterpret_cast<uv_handle_t*>(this->messagesUvHandle), static_cast<uv_close_cb>(onClose));
+
+		throw;
+	}
+
+	// Wait for the thread loop to be running.
+	uv_sem_wait(&this->readySem);
+}
+
+WorkerThread::~WorkerThread()
+{
+	MS_TRACE();
+
+	if (!this->closed)
+		Close();
+}
+
+/**
+ * Closes the Routers of the thread and waits for it to end.
+ */
+void WorkerThread::Close()
+{
+	MS_TRACE();
+
+	if (this->closed)
+		return;
+
+	this->closed = true;
+
+	this->stopping.store(true);
+	uv_async_send(this->requestsUvHandle);
+	// Tell the thread that the async handle is no longer used by us.
+	uv_sem_post(&this->readySem);
+	Join();
+	uv_sem_destroy(&this->readySem);
+
+	// Deliver the messages generated while closing.
+	DeliverMessages();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->messagesUvHandle), static_cast<uv_close_cb>(onClose));
+
+	// Delete requests that were not handled.
+	Channel::Request* request;
+
+	while (this->requests.Pop(request))
+	{
+		delete request;
+	}
+}
+
+/**
+ * Called from the main thread. The thread takes ownership of the request and
+ * replies to it.
+ */
+void WorkerThread::PostRequest(Channel::Request* request)
+{
+	MS_TRACE();
+
+	// The thread always drains the queue so it will have room soon.
+	this->requests.PushWait(std::move(request));
+
+	uv_async_send(this->requestsUvHandle);
+}
+
+void WorkerThread::HandleRequest(Channel::Request* request)
+{
+	MS_TRACE();
+
+	MS_DEBUG_DEV(
+	  "Channel request received [method:%s, id:%" PRIu32 "]", request->method.c_str(), request->id);
+
+	try
+	{
+		switch (request->methodId)
+		{
+			case Channel::Request::MethodId::WORKER_CREATE_ROUTER:
+			{
+				// The Worker already validated the routerId.
+				auto routerId = request->internal["routerId"].get<std::string>();
+				auto* router  = new RTC::Router(routerId);
+
+				this->mapRouters[routerId] = router;
+
+				MS_DEBUG_DEV("Router created [routerId:%s]", routerId.c_str());
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::ROUTER_CLOSE:
+			{
+				// This may throw.
+				RTC::Router* router = GetRouterFromRequest(request);
+
+				MS_DEBUG_DEV("Router closed [id:%s]", router->id.c_str());
+
+				// Remove it from the map and delete it.
+				this->mapRouters.erase(router->id);
+				delete router;
+
+				request->Accept();
+
+				break;
+			}
+
+			// Any other request must be delivered to the corresponding Router.
+			default:
+			{
+				// This may throw.
+				RTC::Router* router = GetRouterFromRequest(request);
+
+				router->HandleRequest(request);
+
+				break;
+			}
+		}
+	}
+	catch (const MediaSoupTypeError& error)
+	{
+		request->TypeError(error.what());
+	}
+	catch (const MediaSoupError& error)
+	{
+		request->Error(error.what());
+	}
+
+	delete request;
+}
+
+RTC::Router* WorkerThread::GetRouterFromRequest(Channel::Request* request) const
+{
+	MS_TRACE();
+
+	auto jsonRouterIdIt = request->internal.find("routerId");
+
+	if (jsonRouterIdIt == request->internal.end() || !jsonRouterIdIt->is_string())
+		MS_THROW_ERROR("request has no internal.routerId");
+
+	auto it = this->mapRouters.find(jsonRouterIdIt->get<std::string>());
+
+	if (it == this->mapRouters.end())
+		MS_THROW_ERROR("Router not found");
+
+	RTC::Router* router = it->second;
+
+	return router;
+}
+
+void WorkerThread::UserOnThread()
+{
+	try
+	{
+		// Initialize the static stuff of this thread loop.
+		DepLibUV::ClassInit();
+		Utils::Crypto::ClassInit();
+		RTC::WebRtcTransport::ClassInit();
+		RTC::EgressPriorityQueue::ClassInit();
+		DepLibUring::ClassInit();
+		UdpSocket::ClassInit();
+		RTC::SharedMemoryPipe::ClassInit();
+		RTC::DtlsHandshakePool::ClassInit();
+
+		this->loopStats = DepLibUV::GetLoopStats();
+
+		this->requestsUvHandle       = new uv_async_t;
+		this->requestsUvHandle->data = (void*)this;
+
+		int err = uv_async_init(
+		  DepLibUV::GetLoop(), this->requestsUvHandle, static_cast<uv_async_cb>(onRequests));
+
+		if (err != 0)
+			MS_THROW_ERROR("uv_async_init() failed: %s", uv_strerror(err));
+	}
+	catch (const MediaSoupError& error)
+	{
+		MS_ABORT("worker thread initialization failed: %s", error.what());
+	}
+
+	uv_sem_post(&this->readySem);
+
+	MS_DEBUG_DEV("starting libuv loop");
+	DepLibUV::RunLoop();
+	MS_DEBUG_DEV("libuv loop ended");
+
+	// Free the static stuff of this thread loop.
+	RTC::WebRtcTransport::ClassDestroy();
+	RTC::EgressPriorityQueue::ClassDestroy();
+	RTC::DtlsHandshakePool::ClassDestroy();
+	DepLibUring::ClassDestroy();
+	UdpSocket::ClassDestroy();
+	BufferPool::ClassDestroy();
+	DepLibUV::ClassDestroy();
+	Utils::Crypto::ClassDestroy();
+	RTC::SharedRtpPacket::ClassDestroy();
+	RTC::RtpPacket::ClassDestroy();
+}
+
+/**
+ * Called from the thread.
+ */
+void WorkerThread::OnUvRequests()
+{
+	MS_TRACE();
+
+	Channel::Request* request;
+
+	while (this->requests.Pop(request))
+	{
+		HandleRequest(request);
+	}
+
+	if (!this->stopping.load())
+		return;
+
+	// Delete all Routers.
+	for (auto& kv : this->mapRouters)
+	{
+		auto* router = kv.second;
+
+		delete router;
+	}
+	this->mapRouters.clear();
+
+	// The thread may see the stopping flag before Close() has sent the async
+	// handle, so wait until it is done with it.
+	uv_sem_wait(&this->readySem);
+
+	// Once closed the loop ends (when the Routers' handles are closed too).
+	uv_close(reinterpret_cast<uv_handle_t*>(this->requestsUvHandle), static_cast<uv_close_cb>(onClose));
+}
+
+/**
+ * Called from the thread.
+ */
+void WorkerThread::NotifyLoop()
+{
+	uv_async_send(this->messagesUvHandle);
+}
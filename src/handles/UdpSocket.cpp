@@ -2,15 +2,56 @@
 // #define MS_LOG_DEV
 
 #include "handles/UdpSocket.hpp"
+#include "BufferPool.hpp"
+#include "DepLibUV.hpp"
+#include "DepLibUring.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memcpy()
+#include <cerrno>
+#include <cstring> // std::memcpy(), std::strerror()
+#ifdef __linux__
+#include <netinet/udp.h> // SOL_UDP, UDP_SEGMENT, UDP_GRO
+#endif
 
 /* Static. */
 
+// NOTE: Buffers, batches and pools belong to the loop of the calling thread.
+// Big buffers are allocated in ClassInit() so threads without a loop (such as
+// the crypto pool ones) do not have them in their static TLS.
 static constexpr size_t ReadBufferSize{ 65536 };
-static uint8_t ReadBuffer[ReadBufferSize];
+static thread_local uint8_t* ReadBuffer{ nullptr };
+// Batched receive (recvmmsg) pool. 0 means disabled.
+static constexpr size_t MaxRecvBatchSize{ 32 };
+static thread_local size_t RecvBatchSize{ 0 };
+#ifdef __linux__
+static thread_local uint8_t* RecvBatchBuffers{ nullptr };
+static thread_local struct sockaddr_storage RecvBatchAddrs[MaxRecvBatchSize];
+static thread_local struct iovec RecvBatchIovs[MaxRecvBatchSize];
+static thread_local struct mmsghdr RecvBatchMsgs[MaxRecvBatchSize];
+// Room for the UDP_GRO segment size cmsg.
+static thread_local uint8_t RecvBatchControls[MaxRecvBatchSize][CMSG_SPACE(sizeof(int))];
+#endif
+// Deferred egress (sendmmsg). Datagrams of all the sockets are copied into a
+// single buffer which is released once every queue has been flushed.
+static constexpr size_t MaxSendBatchSize{ 64 };
+static thread_local size_t SendBatchSize{ 0 };
+static constexpr size_t SendQueueBufferSize{ 262144 };
+static thread_local uint8_t* SendQueueBuffer{ nullptr };
+static thread_local size_t SendQueueBufferUsed{ 0 };
+#ifdef __linux__
+static thread_local struct iovec SendBatchIovs[MaxSendBatchSize];
+static thread_local struct mmsghdr SendBatchMsgs[MaxSendBatchSize];
+// Number of queued datagrams carried by each message (more than 1 for GSO).
+static thread_local size_t SendBatchMsgDatagrams[MaxSendBatchSize];
+#endif
+// UDP GSO (UDP_SEGMENT) limits for a single super-datagram.
+static constexpr size_t MaxGsoSegments{ 64 };
+static constexpr size_t MaxGsoBytes{ 65000 };
+#ifdef __linux__
+static thread_local uint8_t SendBatchControls[MaxSendBatchSize][CMSG_SPACE(sizeof(uint16_t))];
+#endif
 
 /* Static methods for UV callbacks. */
 
@@ -40,16 +81,16 @@ inline static void onSend(uv_udp_send_t* req, int status)
 	auto* sendData = static_cast<UdpSocket::UvSendData*>(req->data);
 	auto* handle   = req->handle;
 	auto* socket   = static_cast<UdpSocket*>(handle->data);
+	size_t len     = sendData->len;
 
-	// Delete the UvSendData struct (which includes the uv_req_t and the store char[]).
-	std::free(sendData);
+	// Give the UvSendData struct (which includes the uv_req_t and the store
+	// char[]) back to the pool.
+	BufferPool::Free(reinterpret_cast<uint8_t*>(sendData));
 
 	if (socket == nullptr)
 		return;
 
-	// Just notify the UdpSocket when error.
-	if (status != 0)
-		socket->OnUvSendError(status);
+	socket->OnUvSend(status, len);
 }
 
 inline static void onClose(uv_handle_t* handle)
@@ -57,6 +98,94 @@ inline static void onClose(uv_handle_t* handle)
 	delete handle;
 }
 
+/* Class variables. */
+
+thread_local std::vector<UdpSocket*> UdpSocket::pendingSockets;
+
+/* Class methods. */
+
+void UdpSocket::ClassInit()
+{
+	MS_TRACE();
+
+	ReadBuffer = new uint8_t[ReadBufferSize];
+
+#ifdef __linux__
+	RecvBatchSize =
+	  std::min(static_cast<size_t>(Settings::configuration.udpRecvBatchSize), MaxRecvBatchSize);
+	SendBatchSize =
+	  std::min(static_cast<size_t>(Settings::configuration.udpSendBatchSize), MaxSendBatchSize);
+
+	if (RecvBatchSize != 0)
+		RecvBatchBuffers = new uint8_t[RecvBatchSize * ReadBufferSize];
+
+	if (SendBatchSize != 0)
+		SendQueueBuffer = new uint8_t[SendQueueBufferSize];
+
+	// Set the constant fields of the receive ring. msg_namelen and msg_flags
+	// are reset before each recvmmsg() call.
+	for (size_t i{ 0 }; i < RecvBatchSize; ++i)
+	{
+		auto& msg = RecvBatchMsgs[i].msg_hdr;
+
+		RecvBatchIovs[i].iov_base = RecvBatchBuffers + (i * ReadBufferSize);
+		RecvBatchIovs[i].iov_len  = ReadBufferSize;
+
+		msg.msg_name       = &RecvBatchAddrs[i];
+		msg.msg_iov        = &RecvBatchIovs[i];
+		msg.msg_iovlen     = 1;
+		msg.msg_control    = nullptr;
+		msg.msg_controllen = 0;
+	}
+
+	for (size_t i{ 0 }; i < MaxSendBatchSize; ++i)
+	{
+		auto& msg = SendBatchMsgs[i].msg_hdr;
+
+		msg.msg_iov        = &SendBatchIovs[i];
+		msg.msg_iovlen     = 1;
+		msg.msg_control    = nullptr;
+		msg.msg_controllen = 0;
+		msg.msg_flags      = 0;
+	}
+
+	if (SendBatchSize != 0)
+		DepLibUV::AddFlushCallback(UdpSocket::FlushAll);
+#endif
+
+	MS_DEBUG_TAG(info, "UDP batch sizes [receive:%zu, send:%zu]", RecvBatchSize, SendBatchSize);
+}
+
+void UdpSocket::ClassDestroy()
+{
+	MS_TRACE();
+
+	delete[] ReadBuffer;
+	ReadBuffer = nullptr;
+
+	delete[] RecvBatchBuffers;
+	RecvBatchBuffers = nullptr;
+
+	delete[] SendQueueBuffer;
+	SendQueueBuffer = nullptr;
+}
+
+void UdpSocket::FlushAll()
+{
+	if (UdpSocket::pendingSockets.empty())
+		return;
+
+	for (auto* socket : UdpSocket::pendingSockets)
+	{
+		socket->FlushSendQueue();
+	}
+
+	UdpSocket::pendingSockets.clear();
+
+	// All the queued datagrams have been sent (or copied), so release the buffer.
+	SendQueueBufferUsed = 0;
+}
+
 /* Instance methods. */
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -68,8 +197,48 @@ UdpSocket::UdpSocket(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 
 	this->uvHandle->data = (void*)this;
 
-	err = uv_udp_recv_start(
-	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+	err = uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), &this->fd);
+
+	if (err != 0)
+	{
+		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+
+		MS_THROW_ERROR("uv_fileno() failed: %s", uv_strerror(err));
+	}
+
+#if defined(__linux__) && defined(UDP_SEGMENT)
+	// Probe UDP GSO support. Kernels without it (< 4.18) fail here instead of
+	// silently sending the whole super-datagram as a single one.
+	int gsoSize{ 0 };
+	socklen_t gsoSizeLen = sizeof(gsoSize);
+
+	this->gsoEnabled =
+	  SendBatchSize != 0 && getsockopt(this->fd, SOL_UDP, UDP_SEGMENT, &gsoSize, &gsoSizeLen) == 0;
+#endif
+
+#if defined(__linux__) && defined(UDP_GRO)
+	// UDP GRO needs the segment size cmsg, so it requires batched receive
+	// (libuv does not read ancillary data).
+	if (Settings::configuration.udpGro && RecvBatchSize != 0 && !DepLibUring::IsActive())
+	{
+		int on{ 1 };
+
+		this->groEnabled = setsockopt(this->fd, SOL_UDP, UDP_GRO, &on, sizeof(on)) == 0;
+
+		if (!this->groEnabled)
+			MS_WARN_TAG(info, "setsockopt(UDP_GRO) failed: %s", std::strerror(errno));
+	}
+#endif
+
+	// Let io_uring read the datagrams. Otherwise (or if it fails) use libuv.
+	if (DepLibUring::IsActive())
+		this->ioUringRecvId = DepLibUring::StartRecv(this, this->fd);
+
+	if (this->ioUringRecvId == 0)
+	{
+		err = uv_udp_recv_start(
+		  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+	}
 
 	if (err != 0)
 	{
@@ -81,6 +250,12 @@ UdpSocket::UdpSocket(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 	// Set local address.
 	if (!SetLocalAddress())
 	{
+		if (this->ioUringRecvId != 0)
+		{
+			DepLibUring::StopRecv(this->ioUringRecvId);
+			DepLibUring::Submit();
+		}
+
 		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 
 		MS_THROW_ERROR("error setting local IP and port");
@@ -102,16 +277,39 @@ void UdpSocket::Close()
 	if (this->closed)
 		return;
 
+	// Send the datagrams waiting in the egress queue.
+	if (this->pendingFlush)
+	{
+		FlushSendQueue();
+
+		UdpSocket::pendingSockets.erase(
+		  std::find(UdpSocket::pendingSockets.begin(), UdpSocket::pendingSockets.end(), this));
+	}
+
 	this->closed = true;
 
 	// Tell the UV handle that the UdpSocket has been closed.
 	this->uvHandle->data = nullptr;
 
 	// Don't read more.
-	int err = uv_udp_recv_stop(this->uvHandle);
+	if (this->ioUringRecvId != 0)
+	{
+		DepLibUring::StopRecv(this->ioUringRecvId);
+	}
+	else
+	{
+		int err = uv_udp_recv_stop(this->uvHandle);
 
-	if (err != 0)
-		MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+		if (err != 0)
+			MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+	}
+
+	// Queued io_uring submissions refer to the fd that is about to be closed.
+	if (DepLibUring::IsActive())
+	{
+		DepLibUring::ForgetSends(this);
+		DepLibUring::Submit();
+	}
 
 	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 }
@@ -124,6 +322,18 @@ void UdpSocket::Dump() const
 	  this->localIp.c_str(),
 	  static_cast<uint16_t>(this->localPort),
 	  (!this->closed) ? "open" : "closed");
+	MS_DUMP(
+	  "  [send batches:%zu, datagrams:%zu, average:%.2f]",
+	  this->sendBatches,
+	  this->sendBatchedDatagrams,
+	  this->sendBatches != 0 ? static_cast<double>(this->sendBatchedDatagrams) / this->sendBatches
+	                         : 0.0);
+	MS_DUMP(
+	  "  [GSO:%s, GSO datagrams:%zu]", this->gsoEnabled ? "yes" : "no", this->sendGsoDatagrams);
+	MS_DUMP(
+	  "  [GRO:%s, GRO datagrams:%zu]", this->groEnabled ? "yes" : "no", this->recvGroDatagrams);
+	MS_DUMP("  [io_uring:%s]", this->ioUringRecvId != 0 ? "yes" : "no");
+	MS_DUMP("  [send queued bytes:%zu, send drops:%zu]", this->sendQueuedBytes, this->sendDrops);
 	MS_DUMP("</UdpSocket>");
 }
 
@@ -131,71 +341,49 @@ void UdpSocket::Send(const uint8_t* data, size_t len, const struct sockaddr* add
 {
 	MS_TRACE();
 
+	Send(data, len, nullptr, 0, addr);
+}
+
+/**
+ * Sends a datagram made of two buffers (such as a rewritten RTP header and
+ * the rest of the packet) without assembling it first.
+ */
+void UdpSocket::Send(
+  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
 	if (this->closed)
 		return;
 
+	size_t len = len1 + len2;
+
 	if (len == 0)
 		return;
 
-	// First try uv_udp_try_send(). In case it can not directly send the datagram
-	// then build a uv_req_t and use uv_udp_send().
-
-	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data)), len);
-	int sent        = uv_udp_try_send(this->uvHandle, &buffer, 1, addr);
-
-	// Entire datagram was sent. Done.
-	if (sent == static_cast<int>(len))
+	// io_uring egress, the submission is done when the loop iteration ends.
+	// NOTE: Once libuv holds datagrams (the socket send buffer was full) keep
+	// using it so they are not overtaken.
+	// clang-format off
+	if (
+		DepLibUring::IsActive() &&
+		this->sendQueuedBytes == 0 &&
+		DepLibUring::PrepareSend(this, this->fd, data1, len1, data2, len2, addr)
+	)
+	// clang-format on
 	{
-		// Update sent bytes.
-		this->sentBytes += sent;
-
 		return;
 	}
-	if (sent >= 0)
-	{
-		MS_WARN_DEV("datagram truncated (just %d of %zu bytes were sent)", sent, len);
-
-		// Update sent bytes.
-		this->sentBytes += sent;
 
-		return;
-	}
-	// Error,
-	if (sent != UV_EAGAIN)
+	// Deferred egress, the datagram will be sent when the loop iteration ends.
+	if (SendBatchSize != 0 && len <= SendQueueBufferSize)
 	{
-		MS_WARN_DEV("uv_udp_try_send() failed: %s", uv_strerror(sent));
+		Enqueue(data1, len1, data2, len2, addr);
 
 		return;
 	}
-	// Otherwise UV_EAGAIN was returned so cannot send data at first time. Use uv_udp_send().
-
-	// MS_DEBUG_DEV("could not send the datagram at first time, using uv_udp_send() now");
-
-	// Allocate a special UvSendData struct pointer.
-	auto* sendData = static_cast<UvSendData*>(std::malloc(sizeof(UvSendData) + len));
-
-	std::memcpy(sendData->store, data, len);
-	sendData->req.data = (void*)sendData;
-
-	buffer = uv_buf_init(reinterpret_cast<char*>(sendData->store), len);
-
-	int err = uv_udp_send(
-	  &sendData->req, this->uvHandle, &buffer, 1, addr, static_cast<uv_udp_send_cb>(onSend));
-
-	if (err != 0)
-	{
-		// NOTE: uv_udp_send() returns error if a wrong INET family is given
-		// (IPv6 destination on a IPv4 binded socket), so be ready.
-		MS_WARN_DEV("uv_udp_send() failed: %s", uv_strerror(err));
 
-		// Delete the UvSendData struct (which includes the uv_req_t and the store char[]).
-		std::free(sendData);
-	}
-	else
-	{
-		// Update sent bytes.
-		this->sentBytes += len;
-	}
+	SendDatagram(data1, len1, data2, len2, addr);
 }
 
 void UdpSocket::Send(const uint8_t* data, size_t len, const std::string& ip, uint16_t port)
@@ -272,10 +460,459 @@ bool UdpSocket::SetLocalAddress()
 	return true;
 }
 
+void UdpSocket::RecvBatch()
+{
+	MS_TRACE();
+
+#ifdef __linux__
+	for (size_t i{ 0 }; i < RecvBatchSize; ++i)
+	{
+		auto& msg = RecvBatchMsgs[i].msg_hdr;
+
+		msg.msg_namelen = sizeof(struct sockaddr_storage);
+		msg.msg_flags   = 0;
+
+		if (this->groEnabled)
+		{
+			msg.msg_control    = RecvBatchControls[i];
+			msg.msg_controllen = sizeof(RecvBatchControls[i]);
+		}
+		else
+		{
+			msg.msg_control    = nullptr;
+			msg.msg_controllen = 0;
+		}
+	}
+
+	int count = recvmmsg(this->fd, RecvBatchMsgs, RecvBatchSize, MSG_DONTWAIT, nullptr);
+
+	if (count < 0)
+	{
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+			return;
+
+		// Kernel without recvmmsg() support, fallback to the libuv read path
+		// for every socket.
+		if (errno == ENOSYS)
+		{
+			MS_WARN_TAG(info, "recvmmsg() not supported, disabling UDP receive batching");
+
+			RecvBatchSize = 0;
+
+			return;
+		}
+
+		MS_DEBUG_DEV("recvmmsg() failed: %s", std::strerror(errno));
+
+		return;
+	}
+
+	for (int i{ 0 }; i < count; ++i)
+	{
+		// The subclass may have closed us while handling a previous datagram.
+		if (this->closed)
+			return;
+
+		auto& msg = RecvBatchMsgs[i];
+
+		if ((msg.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+		{
+			MS_ERROR("received datagram was truncated due to insufficient buffer, ignoring it");
+
+			continue;
+		}
+
+		// Update received bytes.
+		this->recvBytes += msg.msg_len;
+
+		auto* addr = reinterpret_cast<struct sockaddr*>(&RecvBatchAddrs[i]);
+
+		// Coalesced GRO buffer, split it into the original datagrams in place.
+		size_t segmentSize = this->groEnabled ? GetGroSegmentSize(&msg.msg_hdr) : 0;
+
+		if (segmentSize != 0 && segmentSize < msg.msg_len)
+		{
+			for (size_t offset{ 0 }; offset < msg.msg_len; offset += segmentSize)
+			{
+				if (this->closed)
+					return;
+
+				size_t len = std::min(segmentSize, static_cast<size_t>(msg.msg_len) - offset);
+
+				++this->recvGroDatagrams;
+
+				// Notify the subclass.
+				UserOnUdpDatagramReceived(
+				  RecvBatchBuffers + (i * ReadBufferSize) + offset, len, addr);
+			}
+
+			continue;
+		}
+
+		// Notify the subclass.
+		UserOnUdpDatagramReceived(RecvBatchBuffers + (i * ReadBufferSize), msg.msg_len, addr);
+	}
+#endif
+}
+
+size_t UdpSocket::GetGroSegmentSize(const struct msghdr* msg) const
+{
+	MS_TRACE();
+
+#if defined(__linux__) && defined(UDP_GRO)
+	for (auto* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+	     cmsg       = CMSG_NXTHDR(const_cast<struct msghdr*>(msg), cmsg))
+	{
+		if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+		{
+			int segmentSize;
+
+			std::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(int));
+
+			return segmentSize > 0 ? static_cast<size_t>(segmentSize) : 0;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+void UdpSocket::Enqueue(
+  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	size_t len = len1 + len2;
+
+	// No room in the shared buffer, flush every socket now.
+	if (SendQueueBufferUsed + len > SendQueueBufferSize)
+		UdpSocket::FlushAll();
+
+	uint8_t* store = SendQueueBuffer + SendQueueBufferUsed;
+
+	std::memcpy(store, data1, len1);
+
+	if (len2 != 0)
+		std::memcpy(store + len1, data2, len2);
+
+	SendQueueBufferUsed += len;
+
+	this->sendQueue.emplace_back();
+
+	auto& item = this->sendQueue.back();
+
+	item.data = store;
+	item.len  = len;
+
+	switch (addr->sa_family)
+	{
+		case AF_INET:
+			std::memcpy(&item.addr, addr, sizeof(struct sockaddr_in));
+			break;
+
+		case AF_INET6:
+			std::memcpy(&item.addr, addr, sizeof(struct sockaddr_in6));
+			break;
+
+		default:
+			std::memcpy(&item.addr, addr, sizeof(struct sockaddr));
+	}
+
+	if (!this->pendingFlush)
+	{
+		this->pendingFlush = true;
+
+		UdpSocket::pendingSockets.push_back(this);
+	}
+}
+
+void UdpSocket::FlushSendQueue()
+{
+	MS_TRACE();
+
+	this->pendingFlush = false;
+
+	size_t idx{ 0 };
+
+#ifdef __linux__
+	// If libuv already has queued send requests we must not bypass them.
+	while (
+	  idx < this->sendQueue.size() && SendBatchSize != 0 &&
+	  uv_udp_get_send_queue_count(this->uvHandle) == 0)
+	{
+		size_t count{ 0 };
+		size_t itemIdx{ idx };
+
+		while (count < SendBatchSize && itemIdx < this->sendQueue.size())
+		{
+			auto& item       = this->sendQueue[itemIdx];
+			auto& msg        = SendBatchMsgs[count].msg_hdr;
+			size_t runLength = this->gsoEnabled ? GetGsoRunLength(itemIdx) : 1;
+			size_t runBytes{ 0 };
+
+			for (size_t i{ 0 }; i < runLength; ++i)
+			{
+				runBytes += this->sendQueue[itemIdx + i].len;
+			}
+
+			SendBatchIovs[count].iov_base = const_cast<uint8_t*>(item.data);
+			SendBatchIovs[count].iov_len  = runBytes;
+
+			msg.msg_name    = &item.addr;
+			msg.msg_namelen = item.addr.ss_family == AF_INET6 ? sizeof(struct sockaddr_in6)
+			                                                  : sizeof(struct sockaddr_in);
+
+#ifdef UDP_SEGMENT
+			// Several datagrams of same size to the same destination lying contiguous
+			// in memory, let the kernel split them.
+			if (runLength > 1)
+			{
+				msg.msg_control    = SendBatchControls[count];
+				msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+				struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+				cmsg->cmsg_level = SOL_UDP;
+				cmsg->cmsg_type  = UDP_SEGMENT;
+				cmsg->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+
+				auto segmentSize = static_cast<uint16_t>(item.len);
+
+				std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(uint16_t));
+			}
+			else
+#endif
+			{
+				msg.msg_control    = nullptr;
+				msg.msg_controllen = 0;
+			}
+
+			SendBatchMsgDatagrams[count] = runLength;
+
+			itemIdx += runLength;
+			++count;
+		}
+
+		int sent = sendmmsg(this->fd, SendBatchMsgs, count, 0);
+
+		if (sent < 0)
+		{
+			// Socket buffer is full, let libuv send the rest.
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+
+			// Kernel without sendmmsg() support, disable deferred egress.
+			if (errno == ENOSYS)
+			{
+				MS_WARN_TAG(info, "sendmmsg() not supported, disabling UDP send batching");
+
+				SendBatchSize = 0;
+
+				break;
+			}
+
+			// The kernel or the NIC rejected the GSO super-datagram (no checksum
+			// offload, segment bigger than the path MTU...). Disable GSO in this
+			// socket and send the same datagrams again one by one.
+			if (SendBatchMsgDatagrams[0] > 1)
+			{
+				MS_WARN_TAG(
+				  info, "UDP GSO send failed, disabling it in this socket: %s", std::strerror(errno));
+
+				this->gsoEnabled = false;
+
+				continue;
+			}
+
+			// The first datagram failed (wrong destination family, unreachable
+			// network...), drop it and go on.
+			MS_WARN_DEV("sendmmsg() failed: %s", std::strerror(errno));
+
+			++idx;
+
+			continue;
+		}
+
+		for (int i{ 0 }; i < sent; ++i)
+		{
+			// Update sent bytes.
+			this->sentBytes += SendBatchMsgs[i].msg_len;
+
+			this->sendBatchedDatagrams += SendBatchMsgDatagrams[i];
+
+			if (SendBatchMsgDatagrams[i] > 1)
+				this->sendGsoDatagrams += SendBatchMsgDatagrams[i];
+
+			idx += SendBatchMsgDatagrams[i];
+		}
+
+		++this->sendBatches;
+	}
+#endif
+
+	// Remaining datagrams go through the regular path.
+	for (; idx < this->sendQueue.size(); ++idx)
+	{
+		auto& item = this->sendQueue[idx];
+
+		SendDatagram(
+		  item.data, item.len, nullptr, 0, reinterpret_cast<const struct sockaddr*>(&item.addr));
+	}
+
+	this->sendQueue.clear();
+}
+
+size_t UdpSocket::GetGsoRunLength(size_t idx) const
+{
+	MS_TRACE();
+
+	auto& first     = this->sendQueue[idx];
+	auto* firstAddr = reinterpret_cast<const struct sockaddr*>(&first.addr);
+	size_t runBytes = first.len;
+	size_t nextIdx  = idx + 1;
+
+	// Every segment but the last one must have the same size as the first one.
+	while (nextIdx < this->sendQueue.size() && nextIdx - idx < MaxGsoSegments)
+	{
+		auto& previous = this->sendQueue[nextIdx - 1];
+		auto& item     = this->sendQueue[nextIdx];
+
+		if (
+		  item.len > first.len || runBytes + item.len > MaxGsoBytes ||
+		  item.data != previous.data + previous.len ||
+		  !Utils::IP::CompareAddresses(reinterpret_cast<const struct sockaddr*>(&item.addr), firstAddr))
+		{
+			break;
+		}
+
+		runBytes += item.len;
+		++nextIdx;
+
+		// A shorter datagram closes the run.
+		if (item.len < first.len)
+			break;
+	}
+
+	return nextIdx - idx;
+}
+
+void UdpSocket::SendDatagram(
+  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	size_t len = len1 + len2;
+
+	// First try uv_udp_try_send(). In case it can not directly send the datagram
+	// then build a uv_req_t and use uv_udp_send().
+
+	uv_buf_t buffers[2] = {
+		uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data1)), len1),
+		uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data2)), len2)
+	};
+	int sent = uv_udp_try_send(this->uvHandle, buffers, len2 != 0 ? 2 : 1, addr);
+
+	// Entire datagram was sent. Done.
+	if (sent == static_cast<int>(len))
+	{
+		// Update sent bytes.
+		this->sentBytes += sent;
+
+		return;
+	}
+	if (sent >= 0)
+	{
+		MS_WARN_DEV("datagram truncated (just %d of %zu bytes were sent)", sent, len);
+
+		// Update sent bytes.
+		this->sentBytes += sent;
+
+		return;
+	}
+	// Error,
+	if (sent != UV_EAGAIN)
+	{
+		MS_WARN_DEV("uv_udp_try_send() failed: %s", uv_strerror(sent));
+
+		return;
+	}
+	// Otherwise UV_EAGAIN was returned so cannot send data at first time. Use uv_udp_send().
+
+	// MS_DEBUG_DEV("could not send the datagram at first time, using uv_udp_send() now");
+
+	SendWithUvRequest(data1, len1, data2, len2, addr);
+}
+
+void UdpSocket::SendWithUvRequest(
+  const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	size_t len = len1 + len2;
+
+	// Drop the datagram if too many bytes are already waiting in libuv (the
+	// NIC queue is backed up and they would be late anyway).
+	if (
+	  Settings::configuration.udpSendQueueMaxBytes != 0 &&
+	  this->sendQueuedBytes + len > Settings::configuration.udpSendQueueMaxBytes)
+	{
+		MS_DEBUG_DEV("send queue full, dropping datagram");
+
+		++this->sendDrops;
+
+		return;
+	}
+
+	// Get a special UvSendData struct pointer from the pool.
+	auto* sendData =
+	  reinterpret_cast<UdpSocket::UvSendData*>(BufferPool::Allocate(sizeof(UvSendData) + len));
+
+	sendData->len = len;
+
+	std::memcpy(sendData->store, data1, len1);
+
+	if (len2 != 0)
+		std::memcpy(sendData->store + len1, data2, len2);
+
+	sendData->req.data = (void*)sendData;
+
+	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(sendData->store), len);
+
+	int err = uv_udp_send(
+	  &sendData->req, this->uvHandle, &buffer, 1, addr, static_cast<uv_udp_send_cb>(onSend));
+
+	if (err != 0)
+	{
+		// NOTE: uv_udp_send() returns error if a wrong INET family is given
+		// (IPv6 destination on a IPv4 binded socket), so be ready.
+		MS_WARN_DEV("uv_udp_send() failed: %s", uv_strerror(err));
+
+		// Give the UvSendData struct back to the pool.
+		BufferPool::Free(reinterpret_cast<uint8_t*>(sendData));
+	}
+	else
+	{
+		// Update sent and queued bytes.
+		this->sentBytes += len;
+		this->sendQueuedBytes += len;
+	}
+}
+
 inline void UdpSocket::OnUvRecvAlloc(size_t /*suggestedSize*/, uv_buf_t* buf)
 {
 	MS_TRACE();
 
+	// If batched receive is enabled give UV an empty buffer so it does not
+	// read the datagram itself but calls OnUvRecv() with UV_ENOBUFS instead.
+	// We then drain the socket with recvmmsg().
+	if (RecvBatchSize != 0)
+	{
+		buf->base = nullptr;
+		buf->len  = 0;
+
+		return;
+	}
+
 	// Tell UV to write into the static buffer.
 	buf->base = reinterpret_cast<char*>(ReadBuffer);
 	// Give UV all the buffer space.
@@ -295,6 +932,14 @@ inline void UdpSocket::OnUvRecv(
 	if (nread == 0)
 		return;
 
+	// Batched receive, read the pending datagrams by ourselves.
+	if (nread == UV_ENOBUFS && buf->len == 0)
+	{
+		RecvBatch();
+
+		return;
+	}
+
 	// Check flags.
 	if ((flags & UV_UDP_PARTIAL) != 0u)
 	{
@@ -319,14 +964,73 @@ inline void UdpSocket::OnUvRecv(
 	}
 }
 
-inline void UdpSocket::OnUvSendError(int error) // NOLINT(misc-unused-parameters)
+inline void UdpSocket::OnUvSend(int status, size_t len) // NOLINT(misc-unused-parameters)
 {
 	MS_TRACE();
 
+	this->sendQueuedBytes -= len;
+
 	if (this->closed)
 		return;
 
 #ifdef MS_LOG_DEV
-	MS_DEBUG_DEV("send error: %s", uv_strerror(error));
+	if (status != 0)
+		MS_DEBUG_DEV("send error: %s", uv_strerror(status));
 #endif
 }
+
+void UdpSocket::OnIoUringRecv(const uint8_t* data, size_t len, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	if (this->closed)
+		return;
+
+	// Update received bytes.
+	this->recvBytes += len;
+
+	// Notify the subclass.
+	UserOnUdpDatagramReceived(data, len, addr);
+}
+
+void UdpSocket::OnIoUringRecvFailed()
+{
+	MS_TRACE();
+
+	this->ioUringRecvId = 0;
+
+	if (this->closed)
+		return;
+
+	int err = uv_udp_recv_start(
+	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+	if (err != 0)
+		MS_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+}
+
+void UdpSocket::OnIoUringSend(
+  int result, const uint8_t* data, size_t len, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	if (this->closed)
+		return;
+
+	if (result >= 0)
+	{
+		// Update sent bytes.
+		this->sentBytes += len;
+	}
+	// The socket send buffer is full (the fd is non blocking so the kernel
+	// does not wait for room). Let libuv queue the datagram so it counts in
+	// the send queue bytes (and the transport backlog) like any other.
+	else if (result == -EAGAIN)
+	{
+		SendWithUvRequest(data, len, nullptr, 0, addr);
+	}
+	else
+	{
+		MS_WARN_DEV("io_uring sendmsg failed: %s", std::strerror(-result));
+	}
+}
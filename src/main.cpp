@@ -2,7 +2,9 @@
 // #define MS_LOG_DEV
 
 #include "common.hpp"
+#include "BufferPool.hpp"
 #include "DepLibSRTP.hpp"
+#include "DepLibUring.hpp"
 #include "DepLibUV.hpp"
 #include "DepOpenSSL.hpp"
 #include "DepUsrSCTP.hpp"
@@ -13,8 +15,15 @@
 #include "Worker.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/UnixStreamSocket.hpp"
+#include "RTC/DtlsHandshakePool.hpp"
 #include "RTC/DtlsTransport.hpp"
+#include "RTC/EgressPriorityQueue.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/SharedMemoryPipe.hpp"
+#include "RTC/SharedRtpPacket.hpp"
 #include "RTC/SrtpSession.hpp"
+#include "RTC/WebRtcTransport.hpp"
+#include "handles/UdpSocket.hpp"
 #include <cerrno>
 #include <csignal>  // sigaction()
 #include <cstdlib>  // std::_Exit(), std::genenv()
@@ -105,6 +114,12 @@ int main(int argc, char* argv[])
 		DepLibSRTP::ClassInit();
 		DepUsrSCTP::ClassInit();
 		Utils::Crypto::ClassInit();
+		RTC::WebRtcTransport::ClassInit();
+		RTC::EgressPriorityQueue::ClassInit();
+		DepLibUring::ClassInit();
+		UdpSocket::ClassInit();
+		RTC::SharedMemoryPipe::ClassInit();
+		RTC::DtlsHandshakePool::ClassInit();
 		RTC::DtlsTransport::ClassInit();
 		RTC::SrtpSession::ClassInit();
 		Channel::Notifier::ClassInit(channel);
@@ -116,10 +131,18 @@ int main(int argc, char* argv[])
 		Worker worker(channel);
 
 		// Free static stuff.
+		RTC::WebRtcTransport::ClassDestroy();
+		RTC::EgressPriorityQueue::ClassDestroy();
+		RTC::DtlsHandshakePool::ClassDestroy();
+		DepLibUring::ClassDestroy();
+		UdpSocket::ClassDestroy();
+		BufferPool::ClassDestroy();
 		DepLibUV::ClassDestroy();
 		DepLibSRTP::ClassDestroy();
 		Utils::Crypto::ClassDestroy();
 		RTC::DtlsTransport::ClassDestroy();
+		RTC::SharedRtpPacket::ClassDestroy();
+		RTC::RtpPacket::ClassDestroy();
 		DepUsrSCTP::ClassDestroy();
 
 		// Wait a bit so peding messages to stdout/Channel arrive to the Node